@@ -28,7 +28,11 @@
 #if defined(_WIN32)
 #include <windows.h>
 #else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <termios.h>
+#include <unistd.h>
 #endif
 #include "Exceptions.h"
 #include <boost/filesystem.hpp>
@@ -122,6 +126,56 @@ string contentsString(boost::filesystem::path const& _file)
 	return contentsGeneric<string>(_file);
 }
 
+ReadOnlyView::ReadOnlyView(std::string _content)
+{
+	auto const owner = std::make_shared<std::string const>(std::move(_content));
+	m_data = owner->data();
+	m_size = owner->size();
+	m_owner = owner;
+}
+
+#if !defined(_WIN32)
+namespace
+{
+/// Unmaps the file when the last view is released
+class FileMapping
+{
+public:
+	FileMapping(void* _data, size_t _size): m_data(_data), m_size(_size) {}
+	~FileMapping() { munmap(m_data, m_size); }
+	FileMapping(FileMapping const&) = delete;
+	FileMapping& operator=(FileMapping const&) = delete;
+
+private:
+	void* m_data;
+	size_t m_size;
+};
+}
+#endif
+
+ReadOnlyView mapFile(boost::filesystem::path const& _file)
+{
+#if defined(_WIN32)
+	return ReadOnlyView(contentsString(_file));
+#else
+	int const fd = open(_file.c_str(), O_RDONLY);
+	if (fd < 0)
+		return ReadOnlyView();
+	struct stat info;
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0)
+	{
+		close(fd);
+		return ReadOnlyView();
+	}
+	size_t const size = static_cast<size_t>(info.st_size);
+	void* const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return ReadOnlyView(contentsString(_file));
+	return ReadOnlyView(std::make_shared<FileMapping>(data, size), static_cast<char const*>(data), size);
+#endif
+}
+
 void writeFile(boost::filesystem::path const& _file, bytesConstRef _data, bool _writeDeleteRename)
 {
 	if (_writeDeleteRename)
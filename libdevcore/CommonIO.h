@@ -33,6 +33,7 @@
 #include <string>
 #include <iosfwd>
 #include <chrono>
+#include <memory>
 #include "Common.h"
 #include "CommonData.h"
 #include <boost/filesystem.hpp>
@@ -52,6 +53,36 @@ bytesSec contentsSec(boost::filesystem::path const& _file);
 /// If the file doesn't exist or isn't readable, returns an empty container / bytes.
 std::string contentsString(boost::filesystem::path const& _file);
 
+/// Read-only view of a file content or of a string
+/// Copies of the view share the viewed memory, which is released with the last copy
+class ReadOnlyView
+{
+public:
+	ReadOnlyView() {}
+	/// View of _content, moved into the view
+	explicit ReadOnlyView(std::string _content);
+	/// View of _size chars at _data kept alive by _owner
+	ReadOnlyView(std::shared_ptr<void const> const& _owner, char const* _data, size_t _size):
+		m_owner(_owner), m_data(_data), m_size(_size) {}
+
+	char const* data() const { return m_data; }
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	std::string toString() const { return std::string(m_data, m_size); }
+	bytesConstRef ref() const { return bytesConstRef(reinterpret_cast<byte const*>(m_data), m_size); }
+	std::shared_ptr<void const> const& owner() const { return m_owner; }
+
+private:
+	std::shared_ptr<void const> m_owner;
+	char const* m_data = nullptr;
+	size_t m_size = 0;
+};
+
+/// Map the given file into memory and return the read-only view of its contents.
+/// The file is read into memory if it can not be mapped.
+/// If the file doesn't exist or isn't readable, returns an empty view.
+ReadOnlyView mapFile(boost::filesystem::path const& _file);
+
 /// Write the given binary data into the given file, replacing the file if it pre-exists.
 /// Throws exception on error.
 /// @param _writeDeleteRename useful not to lose any data: If set, first writes to another file in
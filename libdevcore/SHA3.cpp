@@ -210,6 +210,43 @@ defsha3(512)
 
 }
 
+namespace
+{
+size_t const c_sha3Rate = 200 - 256 / 4;
+}
+
+void SHA3Stream::append(bytesConstRef _input)
+{
+	uint8_t const* data = _input.data();
+	size_t size = _input.size();
+	while (size > 0)
+	{
+		size_t const chunk = min(size, c_sha3Rate - m_pos);
+		keccak::xorin(m_state + m_pos, data, chunk);
+		m_pos += chunk;
+		data += chunk;
+		size -= chunk;
+		if (m_pos == c_sha3Rate)
+		{
+			keccak::keccakf(m_state);
+			m_pos = 0;
+		}
+	}
+}
+
+h256 SHA3Stream::hash() const
+{
+	// Same padding as keccak::hash with the delimiter of sha3_256
+	uint8_t state[200];
+	memcpy(state, m_state, sizeof(state));
+	state[m_pos] ^= 0x01;
+	state[c_sha3Rate - 1] ^= 0x80;
+	keccak::keccakf(state);
+	h256 ret;
+	memcpy(ret.data(), state, h256::size);
+	return ret;
+}
+
 bool sha3(bytesConstRef _input, bytesRef o_output)
 {
 	// FIXME: What with unaligned memory?
@@ -64,6 +64,23 @@ inline std::string sha3(std::string const& _input, bool _isNibbles) { return asS
 /// Calculate SHA3-256 MAC
 inline void sha3mac(bytesConstRef _secret, bytesConstRef _plain, bytesRef _output) { sha3(_secret.toBytes() + _plain.toBytes()).ref().populate(_output); }
 
+/// SHA3-256 hash of the input given in several parts
+class SHA3Stream
+{
+public:
+	/// Absorb next part of the input
+	void append(bytesConstRef _input);
+	void append(bytes const& _input) { append(bytesConstRef(&_input)); }
+	void append(std::string const& _input) { append(bytesConstRef(_input)); }
+
+	/// SHA3-256 hash of the input appended so far, more input could be appended after
+	h256 hash() const;
+
+private:
+	uint8_t m_state[200] = {};
+	size_t m_pos = 0;  ///< Position in the current block of the state
+};
+
 extern h256 EmptySHA3;
 
 extern h256 EmptyListSHA3;
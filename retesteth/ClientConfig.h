@@ -42,11 +42,11 @@ public:
     ClientConfig(DataObject const& _obj, ClientConfigID const& _id, fs::path _shell = fs::path())
       : object(_obj), m_shellPath(_shell), m_id(_id)
     {
-        requireJsonFields(_obj, "ClientConfig ",
+        static JsonSchema const schema(
             {{"name", {DataType::String}}, {"socketType", {DataType::String}},
                 {"socketAddress", {DataType::String, DataType::Array}},
-                {"forks", {DataType::Array}}},
-            true);
+                {"forks", {DataType::Array}}});
+        requireJsonFields(_obj, "ClientConfig ", schema, true);
 
         for (auto const& name : m_data.atKey("forks").getSubObjects())
             m_networks.push_back(name.asString());
@@ -53,6 +53,10 @@ void printHelp()
          << "Set path to the test repo\n";
     cout << setw(40) << "--singletest <TestFile> <TestName>" << setw(0)
          << "Run test from a custom file\n";
+    cout << setw(40) << "--cache <PathToCacheFolder>" << setw(0)
+         << "Keep parsed test files and signed transactions for the next runs\n";
+    cout << setw(40) << "--rpcconnections <Number>" << setw(0)
+         << "Get the post state accounts over several connections to a client at once\n";
 
     cout << "\nDebugging\n";
     cout << setw(30) << "-d <index>" << setw(25) << "Set the transaction data array index when running GeneralStateTests\n";
@@ -278,6 +282,16 @@ Options::Options(int argc, const char** argv)
                 "testpath is already set! Make sure that testpath is provided as a first option.");
             testpath = std::string{argv[++i]};
 		}
+        else if (arg == "--cache")
+        {
+            throwIfNoArgumentFollows();
+            cacheFolder = boost::filesystem::path(argv[++i]);
+        }
+        else if (arg == "--rpcconnections")
+        {
+            throwIfNoArgumentFollows();
+            rpcConnections = max(1, atoi(argv[++i]));
+        }
 		else if (arg == "--statediff")
 			statediff = true;
 		else if (arg == "--randomcode")
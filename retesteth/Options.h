@@ -32,6 +32,7 @@ public:
     };
 
     size_t threadCount = 1;	///< Execute tests on threads
+    size_t rpcConnections = 1;  ///< Connections to a client to get the post state with
 	bool enableClientsOutput = false; ///< Enable stderr from clients
 	bool vmtrace = false;	///< Create EVM execution tracer
 	bool filltests = false; ///< Create JSON test files from execution results
@@ -50,6 +51,7 @@ public:
 	bool jsontrace = false; ///< Vmtrace to stdout in json format
 	//eth::StandardTrace::DebugOptions jsontraceOptions; ///< output config for jsontrace
 	std::string testpath;	///< Custom test folder path
+    boost::optional<boost::filesystem::path> cacheFolder;  ///< Cache of parsed test files and signed transactions
     unsigned logVerbosity = 1;
 	boost::optional<boost::filesystem::path> randomCodeOptionsPath; ///< Options for random code generation in fuzz tests
     std::vector<std::string> clients;                               ///< Clients to work with
@@ -30,6 +30,7 @@
 #include <csignal>
 
 #include <dataObject/ConvertFile.h>
+#include <dataObject/JsonOutput.h>
 #include <retesteth/EthChecks.h>
 #include <retesteth/ExitHandler.h>
 #include <retesteth/TestHelper.h>
@@ -357,6 +358,19 @@ void RPCSession::test_setChainParams(string const& _config)
     ETH_FAIL_REQUIRE_MESSAGE(rpcCall("test_setChainParams", { _config }) == true, "remote test_setChainParams = false");
 }
 
+void RPCSession::test_setChainParams(DataObject const& _config)
+{
+    // compact json of the config is streamed right into the request, not built as a parameter
+    string request = requestHead("test_setChainParams");
+    {
+        StringJsonOutput out(request);
+        _config.streamJson(out, 0, false);
+    }
+    request += requestTail();
+    ETH_FAIL_REQUIRE_MESSAGE(
+        rpcRequest(request, false) == true, "remote test_setChainParams = false");
+}
+
 void RPCSession::test_rewindToBlock(size_t _blockNr)
 {
     ETH_FAIL_REQUIRE_MESSAGE(rpcCall("test_rewindToBlock", { to_string(_blockNr) }) == true, "remote test_rewintToBlock = false");
@@ -428,39 +442,53 @@ std::string RPCSession::sendRawRequest(string const& _request)
 DataObject RPCSession::rpcCall(
     string const& _methodName, vector<string> const& _args, bool _canFail)
 {
-    string request = "{\"jsonrpc\":\"2.0\",\"method\":\"" + _methodName + "\",\"params\":[";
+    string request = requestHead(_methodName);
     for (size_t i = 0; i < _args.size(); ++i)
     {
         request += _args[i];
         if (i + 1 != _args.size())
             request += ", ";
     }
+    request += requestTail();
+    return rpcRequest(request, _canFail);
+}
+
+string RPCSession::requestHead(string const& _methodName) const
+{
+    return "{\"jsonrpc\":\"2.0\",\"method\":\"" + _methodName + "\",\"params\":[";
+}
 
-    request += "],\"id\":" + to_string(m_rpcSequence) + "}";
-    ++m_rpcSequence;
+string RPCSession::requestTail()
+{
+    return "],\"id\":" + to_string(m_rpcSequence++) + "}";
+}
 
-    ETH_TEST_MESSAGE("Request: " + request);
+DataObject RPCSession::rpcRequest(string const& _request, bool _canFail)
+{
+    ETH_TEST_MESSAGE("Request: " + _request);
     JsonObjectValidator validator;  // read response while counting `{}`
-    string reply = m_socket.sendRequest(request, validator);
+    string reply = m_socket.sendRequest(_request, validator);
     ETH_TEST_MESSAGE("Reply: " + reply);
 
-    DataObject result = ConvertJsoncppStringToData(reply, string(), true);
+    DataObject result =
+        ConvertJsoncppStringToData(dev::ReadOnlyView(std::move(reply)), string(), true);
     if (result.count("error"))
         result["result"] = "";
-    requireJsonFields(result, "rpcCall_response",
+    static JsonSchema const schema(
         {{"jsonrpc", {{DataType::String}, jsonField::Required}},
             {"id", {{DataType::Integer}, jsonField::Required}},
             {"result", {{DataType::String, DataType::Integer, DataType::Bool, DataType::Object,
                             DataType::Array},
                            jsonField::Required}},
             {"error", {{DataType::String, DataType::Object}, jsonField::Optional}}});
+    requireJsonFields(result, "rpcCall_response", schema);
 
     if (result.count("error"))
     {
         test::TestOutputHelper const& helper = test::TestOutputHelper::get();
         m_lastRPCErrorString = "Error on JSON-RPC call (" + helper.testInfo() +
                                "): " + result["error"]["message"].asString() +
-                               " Request: " + request;
+                               " Request: " + _request;
         if (_canFail)
             return DataObject(DataType::Null);
         ETH_FAIL_MESSAGE(m_lastRPCErrorString);
@@ -483,4 +511,54 @@ string const& RPCSession::accountCreateIfNotExists(size_t _id)
 	return m_accounts[_id];
 }
 
+vector<RPCSession*> RPCSession::connections(size_t _count)
+{
+    while (m_connections.size() + 1 < _count)
+        m_connections.emplace_back(new RPCSession(m_socket.type(), m_socket.path()));
+    vector<RPCSession*> result = {this};
+    for (size_t i = 0; i + 1 < _count; i++)
+        result.push_back(m_connections.at(i).get());
+    return result;
+}
+
 RPCSession::RPCSession(Socket::SocketType _type, const string& _path) : m_socket(_type, _path) {}
+
+RPCSession::~RPCSession()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_workerMutex);
+        m_workerStop = true;
+    }
+    m_workerWakeup.notify_all();
+    if (m_worker.joinable())
+        m_worker.join();
+}
+
+std::future<void> RPCSession::runOnWorker(std::function<void()> const& _task)
+{
+    std::packaged_task<void()> task(_task);
+    std::future<void> result = task.get_future();
+    std::lock_guard<std::mutex> lock(m_workerMutex);
+    m_workerTasks.push_back(std::move(task));
+    if (!m_worker.joinable())
+        m_worker = std::thread(&RPCSession::runWorker, this);
+    m_workerWakeup.notify_one();
+    return result;
+}
+
+void RPCSession::runWorker()
+{
+    while (true)
+    {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_workerMutex);
+            m_workerWakeup.wait(lock, [this]() { return m_workerStop || !m_workerTasks.empty(); });
+            if (m_workerTasks.empty())
+                return;
+            task = std::move(m_workerTasks.front());
+            m_workerTasks.pop_front();
+        }
+        task();  // the exception of the task is stored in its future
+    }
+}
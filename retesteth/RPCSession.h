@@ -3,9 +3,16 @@
 #include <boost/noncopyable.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
 #include <string>
 #include <stdio.h>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <retesteth/ethObjects/common.h>
 #include <retesteth/Socket.h>
 
@@ -25,6 +32,7 @@ public:
     static void sessionEnd(std::string const& _threadID, SessionStatus _status);
     static SessionStatus sessionStatus(std::string const& _threadID);
     static void clear();
+    ~RPCSession();
 
 	std::string web3_clientVersion();
 	std::string eth_sendTransaction(std::string const& _transaction);
@@ -49,6 +57,7 @@ public:
     std::string test_getBlockStatus(std::string const& _blockHash);
     std::string test_getLogHash(std::string const& _txHash);
 	void test_setChainParams(std::string const& _config);
+    void test_setChainParams(DataObject const& _config);
 	void test_rewindToBlock(size_t _blockNr);
     void test_modifyTimestamp(unsigned long long _timestamp);
     string test_mineBlocks(int _number);
@@ -67,10 +76,25 @@ public:
     Socket::SocketType getSocketType() const { return m_socket.type(); }
     std::string const& getSocketPath() const { return m_socket.path(); }
 
+    /// This session and up to _count - 1 more connections to the same client
+    /// The connections are opened once, they are for the requests that run on other threads
+    std::vector<RPCSession*> connections(size_t _count);
+
+    /// Run _task on the worker thread of this connection, the tasks run one after another
+    /// The thread is started once and kept while the connection is open
+    /// The future returns when the task is done and rethrows its exception
+    std::future<void> runOnWorker(std::function<void()> const& _task);
+
 private:
     explicit RPCSession(Socket::SocketType _type, std::string const& _path);
+    void runWorker();
     static void runNewInstanceOfAClient(std::string const& _threadID, ClientConfig const& _config);
 
+    /// Json-rpc request is head + params + tail, the tail takes the next request id
+    std::string requestHead(std::string const& _methodName) const;
+    std::string requestTail();
+    DataObject rpcRequest(std::string const& _request, bool _canFail);
+
     inline std::string quote(std::string const& _arg) { return "\"" + _arg + "\""; }
 	/// Parse std::string replacing keywords to values
 	void parseString(std::string& _string, std::map<std::string, std::string> const& _varMap);
@@ -83,6 +107,13 @@ private:
     string m_lastRPCErrorString;          // last RPC error string
 
     std::vector<std::string> m_accounts;
+    std::vector<std::unique_ptr<RPCSession>> m_connections;  // more connections to the client
+
+    std::mutex m_workerMutex;
+    std::condition_variable m_workerWakeup;  // a task is added or the worker is stopped
+    std::deque<std::packaged_task<void()>> m_workerTasks;
+    bool m_workerStop = false;
+    std::thread m_worker;
 };
 
 
@@ -0,0 +1,103 @@
+/*
+	This file is part of cpp-ethereum.
+
+	cpp-ethereum is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	cpp-ethereum is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file
+ * Cache of the signed transactions
+ */
+
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/SignedTransactionCache.h>
+#include <iostream>
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+namespace test
+{
+SignedTransactionCache& SignedTransactionCache::get()
+{
+    static SignedTransactionCache instance;
+    return instance;
+}
+
+SignedTransactionCache::SignedTransactionCache()
+{
+    boost::optional<fs::path> const& folder = Options::get().cacheFolder;
+    if (!folder.is_initialized())
+        return;
+
+    // Entry line: <key hex> <signed rlp hex>
+    fs::path const file = folder.get() / "signedTransactions.txt";
+    try
+    {
+        fs::create_directories(folder.get());
+        if (fs::exists(file))
+            readFile(file);
+        m_file.open(file, std::ios::app);
+    }
+    catch (std::exception const& _ex)
+    {
+        ETH_STDERROR_MESSAGE("Could not open signed transaction cache " + file.string() + ": " +
+                             _ex.what());
+    }
+}
+
+void SignedTransactionCache::readFile(fs::path const& _file)
+{
+    fs::ifstream in(_file);
+    string key;
+    string signedRLP;
+    while (in >> key >> signedRLP)
+    {
+        // A line written partly by an interrupted run is skipped
+        if (key.size() != 64 || signedRLP.compare(0, 2, "0x") != 0)
+            continue;
+        m_entries[dev::h256(key)] = signedRLP;
+    }
+}
+
+string SignedTransactionCache::load(dev::h256 const& _key, std::function<string()> const& _sign)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto const it = m_entries.find(_key);
+        if (it != m_entries.end())
+        {
+            m_hits++;
+            return it->second;
+        }
+    }
+
+    // Signing is done without the lock, a transaction signed by two threads at once is the same
+    string const signedRLP = _sign();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_misses++;
+    if (m_entries.emplace(_key, signedRLP).second && m_file.is_open())
+        m_file << _key.hex() << " " << signedRLP << std::endl;
+    return signedRLP;
+}
+
+void SignedTransactionCache::printStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t const requests = m_hits + m_misses;
+    if (requests == 0)
+        return;
+    std::cout << "*** Signed transaction cache: " << m_hits << " hits of " << requests
+              << " signatures (" << m_hits * 100 / requests << "%)" << std::endl;
+}
+}  // namespace test
@@ -0,0 +1,57 @@
+/*
+	This file is part of cpp-ethereum.
+
+	cpp-ethereum is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	cpp-ethereum is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file
+ * Cache of the signed transactions
+ */
+
+#pragma once
+#include <libdevcore/FixedHash.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace test
+{
+/// Signed RLP of the transactions keyed by the hash of the unsigned transaction and secret key
+/// Shared by the test threads. With --cache <folder> the entries are also appended to
+/// <folder>/signedTransactions.txt and loaded from it by the next runs
+class SignedTransactionCache
+{
+public:
+    static SignedTransactionCache& get();
+
+    /// Return signed RLP of the transaction _key
+    /// Call _sign and store the result if it is not cached
+    std::string load(dev::h256 const& _key, std::function<std::string()> const& _sign);
+
+    /// Print the cache hit rate
+    void printStats();
+
+private:
+    SignedTransactionCache();
+    void readFile(boost::filesystem::path const& _file);
+
+    std::mutex m_mutex;
+    std::unordered_map<dev::h256, std::string> m_entries;
+    boost::filesystem::ofstream m_file;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+};
+}  // namespace test
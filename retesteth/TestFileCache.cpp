@@ -0,0 +1,206 @@
+/*
+	This file is part of cpp-ethereum.
+
+	cpp-ethereum is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	cpp-ethereum is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file
+ * On disk cache of the parsed test files
+ */
+
+#include <dataObject/ConvertBinary.h>
+#include <dataObject/ConvertFile.h>
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/SHA3.h>
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/TestFileCache.h>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+using namespace dataobject;
+namespace fs = boost::filesystem;
+
+namespace
+{
+uint32_t const c_entryVersion = 2;
+char const c_entryMagic[] = "RTFC";
+size_t const c_entryHeaderSize = 4 + 4 + 4 + 8 * 4;
+
+// Entry header: "RTFC" u32:version u32:parserVersion u64:mtime u64:size u64:contentHash
+// u64:parseMicroseconds
+// An entry written by another version of the format or of the parser is parsed again
+struct EntryHeader
+{
+    uint64_t mtime;
+    uint64_t size;
+    uint64_t contentHash;
+    uint64_t parseMicroseconds;
+};
+
+uint64_t contentHash(dev::ReadOnlyView const& _content)
+{
+    // FNV-1a, catches the edits that keep the modification time and size of the file
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < _content.size(); i++)
+        hash = (hash ^ static_cast<unsigned char>(_content.data()[i])) * 1099511628211ull;
+    return hash;
+}
+
+void appendU32(string& _out, uint32_t _value)
+{
+    for (size_t i = 0; i < 4; i++)
+        _out.push_back(static_cast<char>(_value >> (8 * i)));
+}
+
+void appendU64(string& _out, uint64_t _value)
+{
+    for (size_t i = 0; i < 8; i++)
+        _out.push_back(static_cast<char>(_value >> (8 * i)));
+}
+
+uint32_t readU32(char const* _in, size_t _pos)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; i++)
+        value |= uint32_t(static_cast<unsigned char>(_in[_pos + i])) << (8 * i);
+    return value;
+}
+
+uint64_t readU64(char const* _in, size_t _pos)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; i++)
+        value |= uint64_t(static_cast<unsigned char>(_in[_pos + i])) << (8 * i);
+    return value;
+}
+
+string writeHeader(EntryHeader const& _header)
+{
+    string out(c_entryMagic, 4);
+    appendU32(out, c_entryVersion);
+    appendU32(out, c_parserVersion);
+    appendU64(out, _header.mtime);
+    appendU64(out, _header.size);
+    appendU64(out, _header.contentHash);
+    appendU64(out, _header.parseMicroseconds);
+    return out;
+}
+
+bool readHeader(dev::ReadOnlyView const& _entry, EntryHeader& _header)
+{
+    char const* data = _entry.data();
+    if (_entry.size() < c_entryHeaderSize || std::memcmp(data, c_entryMagic, 4) != 0 ||
+        readU32(data, 4) != c_entryVersion || readU32(data, 8) != c_parserVersion)
+        return false;
+    _header.mtime = readU64(data, 12);
+    _header.size = readU64(data, 20);
+    _header.contentHash = readU64(data, 28);
+    _header.parseMicroseconds = readU64(data, 36);
+    return true;
+}
+
+int64_t microsecondsSince(chrono::steady_clock::time_point const& _start)
+{
+    return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - _start)
+        .count();
+}
+}  // namespace
+
+namespace test
+{
+TestFileCache& TestFileCache::get()
+{
+    static TestFileCache instance;
+    return instance;
+}
+
+TestFileCache::TestFileCache() : m_folder(Options::get().cacheFolder) {}
+
+fs::path TestFileCache::entryPath(fs::path const& _file, string const& _variant) const
+{
+    string const key = fs::absolute(_file).string() + "\n" + _variant;
+    return m_folder.get() / (dev::sha3(key).hex() + ".bin");
+}
+
+DataObject TestFileCache::load(fs::path const& _file, string const& _variant,
+    dev::ReadOnlyView const& _content, std::function<DataObject()> const& _parse)
+{
+    if (!m_folder.is_initialized())
+        return _parse();
+
+    EntryHeader current;
+    current.mtime = static_cast<uint64_t>(fs::last_write_time(_file));
+    current.size = _content.size();
+    current.contentHash = contentHash(_content);
+
+    auto const start = chrono::steady_clock::now();
+    fs::path const entryFile = entryPath(_file, _variant);
+    if (fs::exists(entryFile))
+    {
+        // strings of the loaded DataObject stay in the mapped entry file
+        dev::ReadOnlyView const entry = dev::mapFile(entryFile);
+        EntryHeader cached;
+        if (readHeader(entry, cached) && cached.mtime == current.mtime &&
+            cached.size == current.size && cached.contentHash == current.contentHash)
+        {
+            try
+            {
+                DataObject data = ConvertBinaryToData(entry, c_entryHeaderSize);
+                int64_t const loadTime = microsecondsSince(start);
+                std::lock_guard<std::mutex> lock(m_statsMutex);
+                m_reads++;
+                m_hits++;
+                m_savedMicroseconds += static_cast<int64_t>(cached.parseMicroseconds) - loadTime;
+                return data;
+            }
+            catch (DataObjectException const&)
+            {
+                // broken entry is overwritten below
+            }
+        }
+    }
+
+    DataObject data = _parse();
+    current.parseMicroseconds = static_cast<uint64_t>(microsecondsSince(start));
+    string const entry = writeHeader(current) + ConvertDataToBinary(data);
+
+    // every thread of every process writes own temporary file, the entry is replaced at once
+    try
+    {
+        fs::path const tempFile = entryFile.string() + "." + fs::unique_path().string() + ".tmp";
+        dev::writeFile(tempFile, dev::bytesConstRef(entry));
+        fs::rename(tempFile, entryFile);
+    }
+    catch (std::exception const& _ex)
+    {
+        ETH_STDERROR_MESSAGE("Could not write test file cache " + entryFile.string() + ": " + _ex.what());
+    }
+
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_reads++;
+    return data;
+}
+
+void TestFileCache::printStats()
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    if (!m_folder.is_initialized() || m_reads == 0)
+        return;
+    std::cout << "*** Test file cache: " << m_hits << " hits of " << m_reads << " reads ("
+              << m_hits * 100 / m_reads << "%), parse time saved: "
+              << m_savedMicroseconds / 1000 << " ms" << std::endl;
+}
+}  // namespace test
@@ -0,0 +1,57 @@
+/*
+	This file is part of cpp-ethereum.
+
+	cpp-ethereum is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	cpp-ethereum is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file
+ * On disk cache of the parsed test files
+ */
+
+#pragma once
+#include <dataObject/DataObject.h>
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <functional>
+#include <mutex>
+
+namespace test
+{
+/// Cache of the parsed fillers and tests in binary DataObject format (--cache <folder>)
+/// An entry is keyed by the file path and a variant name (the way the file is parsed)
+/// and is used while the file has the same modification time, size and content hash
+class TestFileCache
+{
+public:
+    static TestFileCache& get();
+
+    /// Return DataObject of the test file _file with the content _content
+    /// Load it from the cache if the entry is valid, otherwise call _parse and store the result
+    dataobject::DataObject load(boost::filesystem::path const& _file, std::string const& _variant,
+        dev::ReadOnlyView const& _content, std::function<dataobject::DataObject()> const& _parse);
+
+    /// Print the cache hit rate and the parse time saved with the cache
+    void printStats();
+
+private:
+    TestFileCache();
+    boost::filesystem::path entryPath(
+        boost::filesystem::path const& _file, std::string const& _variant) const;
+
+    boost::optional<boost::filesystem::path> m_folder;
+    std::mutex m_statsMutex;
+    size_t m_reads = 0;
+    size_t m_hits = 0;
+    int64_t m_savedMicroseconds = 0;
+};
+}  // namespace test
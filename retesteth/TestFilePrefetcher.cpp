@@ -0,0 +1,134 @@
+/*
+	This file is part of cpp-ethereum.
+
+	cpp-ethereum is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	cpp-ethereum is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file
+ * Reading and parsing of the test files ahead of the test threads
+ */
+
+#include <retesteth/TestFilePrefetcher.h>
+#include <retesteth/TestOutputHelper.h>
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+namespace test
+{
+TestFilePrefetcher::TestFilePrefetcher(
+    vector<fs::path> const& _files, Loader const& _load, size_t _threads, size_t _capacity)
+  : m_load(_load), m_capacity(max<size_t>(_capacity, 1))
+{
+    m_entries.reserve(_files.size());
+    for (auto const& file : _files)
+    {
+        m_index[file] = m_entries.size();
+        m_entries.push_back({file, State::Queued, TestFileData()});
+    }
+    for (size_t i = 0; i < _threads && i < _files.size(); i++)
+        m_threads.emplace_back(&TestFilePrefetcher::loadFiles, this);
+}
+
+TestFilePrefetcher::~TestFilePrefetcher()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_space.notify_all();
+    for (auto& th : m_threads)
+        th.join();
+}
+
+void TestFilePrefetcher::loadFiles()
+{
+    while (true)
+    {
+        size_t i = 0;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_space.wait(lock, [this]() {
+                return m_stop || m_next == m_entries.size() || m_pending < m_capacity;
+            });
+            if (m_stop || m_next == m_entries.size())
+                return;
+            i = m_next++;
+            // The test thread came first and reads the file itself
+            if (m_entries.at(i).state != State::Queued)
+                continue;
+            m_entries.at(i).state = State::Loading;
+            m_pending++;
+        }
+
+        TestFileData data;
+        bool loaded = false;
+        try
+        {
+            data = m_load(m_entries.at(i).file);
+            loaded = true;
+        }
+        catch (...)
+        {
+        }
+        // A file with errors is read again by the test thread, which reports them
+        // The errors marked in this thread would be counted twice in the stats
+        TestOutputHelper& output = TestOutputHelper::get();
+        if (!output.getErrors().empty())
+        {
+            loaded = false;
+            output.resetErrors();
+        }
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            Entry& entry = m_entries.at(i);
+            if (loaded)
+            {
+                entry.data = std::move(data);
+                entry.state = State::Loaded;
+            }
+            else
+            {
+                entry.state = State::Failed;
+                m_pending--;
+            }
+        }
+        m_loaded.notify_all();
+        if (!loaded)
+            m_space.notify_all();
+    }
+}
+
+boost::optional<TestFileData> TestFilePrefetcher::take(fs::path const& _file)
+{
+    boost::optional<TestFileData> result;
+    {
+        unique_lock<mutex> lock(m_mutex);
+        auto const it = m_index.find(_file);
+        if (it == m_index.end())
+            return result;
+        Entry& entry = m_entries.at(it->second);
+        m_loaded.wait(lock, [&entry]() { return entry.state != State::Loading; });
+        if (entry.state == State::Loaded)
+        {
+            result = std::move(entry.data);
+            entry.data = TestFileData();
+            m_pending--;
+        }
+        entry.state = State::Taken;
+    }
+    m_space.notify_all();
+    return result;
+}
+}  // namespace test
@@ -0,0 +1,85 @@
+/*
+	This file is part of cpp-ethereum.
+
+	cpp-ethereum is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	cpp-ethereum is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file
+ * Reading and parsing of the test files ahead of the test threads
+ */
+
+#pragma once
+#include <dataObject/DataObject.h>
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace test
+{
+/// Parsed test file and the hash of its content
+struct TestFileData
+{
+    dataobject::DataObject data;
+    dev::h256 hash;
+};
+
+/// Loads the given files in order on a few background threads while the tests are running
+/// At most _capacity files are loaded and not taken yet, so the memory use stays bounded
+class TestFilePrefetcher
+{
+public:
+    typedef std::function<TestFileData(boost::filesystem::path const&)> Loader;
+    TestFilePrefetcher(std::vector<boost::filesystem::path> const& _files, Loader const& _load,
+        size_t _threads, size_t _capacity);
+    ~TestFilePrefetcher();
+
+    /// Return loaded _file, wait for it if it is being loaded
+    /// Return none if _file is not in the list, not loaded yet or failed to load (or marked errors),
+    /// then the caller reads it itself (and reports the errors in its own thread)
+    boost::optional<TestFileData> take(boost::filesystem::path const& _file);
+
+private:
+    enum class State
+    {
+        Queued,
+        Loading,
+        Loaded,
+        Failed,
+        Taken
+    };
+    struct Entry
+    {
+        boost::filesystem::path file;
+        State state;
+        TestFileData data;
+    };
+    void loadFiles();
+
+    Loader m_load;
+    size_t m_capacity;
+    std::vector<Entry> m_entries;
+    std::map<boost::filesystem::path, size_t> m_index;
+    size_t m_next = 0;     // next entry to load
+    size_t m_pending = 0;  // entries being loaded or loaded and not taken
+    bool m_stop = false;
+    std::mutex m_mutex;
+    std::condition_variable m_loaded;  // an entry is loaded or failed
+    std::condition_variable m_space;   // an entry is taken
+    std::vector<std::thread> m_threads;
+};
+}  // namespace test
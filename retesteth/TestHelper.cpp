@@ -8,8 +8,10 @@
 #include <boost/uuid/uuid_io.hpp>          // streaming operators etc
 #include <boost/uuid/uuid_io.hpp>
 #include <csignal>
+#include <map>
 #include <mutex>
 
+#include <libdevcore/SHA3.h>
 #include <retesteth/TestHelper.h>
 #include <retesteth/TestOutputHelper.h>
 #include <retesteth/Options.h>
@@ -271,11 +273,15 @@ string prepareVersionString()
 
 string prepareLLLCVersionString()
 {
-    string result = test::executeCmd("lllc --version");
-    string::size_type pos = result.rfind("Version");
-    if (pos != string::npos)
-        return result.substr(pos, result.length());
-    return "Error getting LLLC Version";
+    // lllc is probed once per process
+    static string const version = []() -> string {
+        string result = test::executeCmd("lllc --version");
+        string::size_type pos = result.rfind("Version");
+        if (pos != string::npos)
+            return result.substr(pos, result.length());
+        return "Error getting LLLC Version";
+    }();
+    return version;
 }
 
 string executeCmd(string const& _command)
@@ -315,19 +321,97 @@ void checkHexHasEvenLength(string const& _hex)
                                     ": Hex field is expected to be of odd length: '" + _hex + "'");
 }
 
+namespace
+{
+// Compiled code keyed by the hash of the lllc version and the source
+// Kept in memory and in <cache folder>/lll/<key>.hex if --cache is set
+class CompiledLLLCache
+{
+public:
+	static CompiledLLLCache& get()
+	{
+		static CompiledLLLCache instance;
+		return instance;
+	}
+
+	bool find(dev::h256 const& _key, string& _code)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto const it = m_entries.find(_key);
+			if (it != m_entries.end())
+			{
+				_code = it->second;
+				return true;
+			}
+		}
+		if (!m_folder.is_initialized() || !fs::exists(entryPath(_key)))
+			return false;
+		_code = dev::contentsString(entryPath(_key));
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_entries[_key] = _code;
+		return true;
+	}
+
+	void store(dev::h256 const& _key, string const& _code)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_entries[_key] = _code;
+		}
+		if (!m_folder.is_initialized())
+			return;
+		// every thread of every process writes own temporary file, the entry is replaced at once
+		try
+		{
+			fs::create_directories(entryPath(_key).parent_path());
+			fs::path const tempFile =
+				entryPath(_key).string() + "." + fs::unique_path().string() + ".tmp";
+			dev::writeFile(tempFile, dev::asBytes(_code));
+			fs::rename(tempFile, entryPath(_key));
+		}
+		catch (std::exception const& _ex)
+		{
+			ETH_STDERROR_MESSAGE("Could not write lll cache " + entryPath(_key).string() + ": " +
+								 _ex.what());
+		}
+	}
+
+private:
+	CompiledLLLCache() : m_folder(Options::get().cacheFolder) {}
+	fs::path entryPath(dev::h256 const& _key) const
+	{
+		return m_folder.get() / "lll" / (_key.hex() + ".hex");
+	}
+
+	boost::optional<fs::path> m_folder;
+	std::mutex m_mutex;
+	std::map<dev::h256, string> m_entries;
+};
+}  // namespace
+
 string compileLLL(string const& _code)
 {
 #if defined(_WIN32)
 	BOOST_ERROR("LLL compilation only supported on posix systems.");
 	return "";
 #else
+	// Same source compiled by the same lllc gives the same code
+	dev::h256 const key = dev::sha3(prepareLLLCVersionString() + "\n" + _code);
+	string result;
+	if (CompiledLLLCache::get().find(key, result))
+		return result;
+
 	fs::path path(fs::temp_directory_path() / fs::unique_path());
 	string cmd = string("lllc ") + path.string();
 	writeFile(path.string(), _code);
-	string result = executeCmd(cmd);
+	result = executeCmd(cmd);
 	fs::remove_all(path);
 	result = "0x" + result;
 	checkHexHasEvenLength(result);
+	// a failed compilation gives no code and is not cached
+	if (result.size() > 2)
+		CompiledLLLCache::get().store(key, result);
 	return result;
 #endif
 }
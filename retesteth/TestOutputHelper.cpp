@@ -25,6 +25,8 @@
 #include <retesteth/TestOutputHelper.h>
 #include <retesteth/Options.h>
 #include <retesteth/ExitHandler.h>
+#include <retesteth/SignedTransactionCache.h>
+#include <retesteth/TestFileCache.h>
 #include <libdevcore/Log.h>
 
 using namespace std;
@@ -176,6 +178,8 @@ void TestOutputHelper::printTestExecStats()
         for (size_t i = 0; i < execTimeResults.size(); i++)
             std::cout << setw(45) << execTimeResults[i].second << setw(25) << " time: " + toString(execTimeResults[i].first) << "\n";
     }
+    TestFileCache::get().printStats();
+    SignedTransactionCache::get().printStats();
 
     if (execTotalErrors)
     {
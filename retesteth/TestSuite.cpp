@@ -21,6 +21,7 @@
 #include <dataObject/ConvertFile.h>
 #include <dataObject/ConvertYaml.h>
 #include <dataObject/DataObject.h>
+#include <dataObject/JsonOutput.h>
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/Log.h>
 #include <libdevcore/SHA3.h>
@@ -28,10 +29,13 @@
 #include <retesteth/ExitHandler.h>
 #include <retesteth/Options.h>
 #include <retesteth/RPCSession.h>
+#include <retesteth/TestFileCache.h>
+#include <retesteth/TestFilePrefetcher.h>
 #include <retesteth/TestHelper.h>
 #include <retesteth/TestOutputHelper.h>
 #include <retesteth/TestSuite.h>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 #include <string>
 #include <thread>
 
@@ -42,30 +46,59 @@ namespace fs = boost::filesystem;
 
 //Helper functions for test proccessing
 namespace {
-struct TestFileData
-{
-    DataObject data;
-    h256 hash;
-};
-
-TestFileData readTestFile(fs::path const& _testFileName)
+// Read test file and the hash of its content
+// Members filtered by _skip are dropped from the data, but still included in the hash
+TestFileData readTestFile(
+    fs::path const& _testFileName, dataobject::KeyFilter const& _skip = dataobject::KeyFilter())
 {
     TestFileData testData;
 
     // Check that file is not empty
-    string const s = dev::contentsString(_testFileName);
+    dev::ReadOnlyView const s = dev::mapFile(_testFileName);
     ETH_ERROR_REQUIRE_MESSAGE(
-        s.length() > 0, "Contents of " + _testFileName.string() + " is empty.");
+        s.size() > 0, "Contents of " + _testFileName.string() + " is empty.");
 
+    // Parsed file content is taken from the cache if --cache is set
+    TestFileCache& cache = TestFileCache::get();
+
+    string variant;
+    std::function<DataObject()> parse;
     if (_testFileName.extension() == ".json")
-        testData.data = dataobject::ConvertJsoncppStringToData(s, string(), true);
+    {
+        variant = "json autosort";
+        parse = [&s]() {
+            dataobject::JsonParseOptions options;
+            options.autosort = true;
+            return dataobject::ConvertJsoncppStringToData(s, options);
+        };
+    }
     else if (_testFileName.extension() == ".yml")
-        testData.data = dataobject::ConvertYamlToData(YAML::Load(s));
+    {
+        variant = "yaml";
+        parse = [&s]() { return dataobject::ConvertYamlToData(s); };
+    }
     else
         ETH_ERROR_MESSAGE(
             "Unknown test format!" + test::TestOutputHelper::get().testFile().string());
 
-    string srcString = testData.data.asJson(0, false); //json_spirit::write_string(testData.data, false);
+    // The file is parsed once: the hash is taken from the whole data, then the skipped keys
+    // are removed. Both are cached in one entry {"hash", "data"}
+    variant += " with hash";
+    if (!_skip.empty())
+        variant += " " + _skip.id();
+    DataObject const entry = cache.load(_testFileName, variant, s, [&parse, &_skip]() {
+        DataObject data = parse();
+        DataObject entry;
+        entry.addSubObject(
+            "hash", DataObject(toString(dataobject::HashDataObjectJson(data, false))));
+        if (!_skip.empty())
+            data.removeFilteredKeys(_skip);
+        entry.addSubObject("data", data);
+        return entry;
+    });
+    testData.hash = entry.atKey("hash").asH256();
+    testData.data = entry.atKey("data");
+
     if (test::Options::get().showhash)
     {
         std::string output = "Not a Json object!";
@@ -77,34 +110,15 @@ TestFileData readTestFile(fs::path const& _testFileName)
             output = output.substr(0, output.size() - 1);
         }
         std::cerr << "JSON: '" << std::endl << output << "'" << std::endl;
-        std::cerr << "DATA: '" << std::endl << srcString << "'" << std::endl;
+        std::cerr << "DATA: '" << std::endl << parse().asJson(0, false) << "'" << std::endl;
     }
-    testData.hash = sha3(srcString);
     return testData;
 }
 
-void removeComments(dataobject::DataObject& _obj)
+// Comment keys "//..." are not part of the filler data, but of its hash
+TestFileData readFiller(fs::path const& _fillerName)
 {
-    if (_obj.type() == dataobject::DataType::Object)
-    {
-		list<string> removeList;
-        for (auto& i: _obj.getSubObjectsUnsafe())
-		{
-            if (i.getKey().substr(0, 2) == "//")
-			{
-                removeList.push_back(i.getKey());
-				continue;
-			}
-            removeComments(i);
-		}
-        for (auto const& i: removeList)
-            _obj.removeKey(i);
-	}
-    else if (_obj.type() == dataobject::DataType::Array)
-    {
-        for (auto& i: _obj.getSubObjectsUnsafe())
-			removeComments(i);
-    }
+    return readTestFile(_fillerName, dataobject::KeyFilter().skipPrefix("//"));
 }
 
 void addClientInfo(
@@ -137,10 +151,18 @@ void addClientInfo(
 
 void checkFillerHash(fs::path const& _compiledTest, fs::path const& _sourceTest)
 {
-    dataobject::DataObject v =
-        dataobject::ConvertJsoncppStringToData(dev::contentsString(_compiledTest), "_info");
+    // Only _info sections of the tests are parsed
+    dev::ReadOnlyView const content = dev::mapFile(_compiledTest);
+    DataObject const infos = TestFileCache::get().load(_compiledTest, "json _info", content,
+        [&content]() {
+            dataobject::LazyJsonDocument const document(content);
+            DataObject tests(dataobject::DataType::Object);
+            for (string const& testName : document.getKeys())
+                tests.getSubObjectsUnsafe().push_back(document.getMember(testName, "_info"));
+            return tests;
+        });
     TestFileData fillerData = readTestFile(_sourceTest);
-    for (auto const& i: v.getSubObjects())
+    for (auto const& i : infos.getSubObjects())
     {
         try
         {
@@ -152,7 +174,7 @@ void checkFillerHash(fs::path const& _compiledTest, fs::path const& _sourceTest)
             dataobject::DataObject const& info = i.atKey("_info");
             ETH_ERROR_REQUIRE_MESSAGE(info.count("sourceHash") > 0,
                 "sourceHash not found in " + _compiledTest.string() + " in " + i.getKey());
-            h256 const sourceHash = h256(info.atKey("sourceHash").asString());
+            h256 const sourceHash = info.atKey("sourceHash").asH256();
             ETH_ERROR_REQUIRE_MESSAGE(sourceHash == fillerData.hash,
                 "Test " + _compiledTest.string() + " in " + i.getKey() +
                     " is outdated. Filler hash is different! ( '" + sourceHash.hex().substr(0, 4) +
@@ -165,6 +187,45 @@ void checkFillerHash(fs::path const& _compiledTest, fs::path const& _sourceTest)
     }
 }
 
+// Parse only the tests selected by --singletest (and --singlenet) from a big test file
+// A test is selected by its name, or by the name with a network or index suffix after '_'
+// The whole file is parsed if it has no such test, so the test suite reports the error
+DataObject readTestsToRun(fs::path const& _file)
+{
+    dev::ReadOnlyView const content = dev::mapFile(_file);
+    test::Options const& opt = test::Options::get();
+    if (opt.singleTest)
+    {
+        dataobject::LazyJsonDocument const document(content);
+        string const& name = opt.singleTestName;
+        string const prefix = opt.singleTestNet.empty() ? name + "_" : name + "_" + opt.singleTestNet;
+        bool const exactSuffix = !opt.singleTestNet.empty();
+        auto const selected = [&name, &prefix, exactSuffix](string const& _key) {
+            if (_key == name)
+                return true;
+            if (exactSuffix)
+                return _key == prefix;
+            return _key.compare(0, prefix.size(), prefix) == 0;
+        };
+        vector<string> const& keys = document.getKeys();
+        if (std::none_of(keys.begin(), keys.end(), selected))
+            return document.getMembers();
+        return document.getMembers(selected);
+    }
+    return TestFileCache::get().load(_file, "json", content,
+        [&content]() { return dataobject::ConvertJsoncppStringToData(content); });
+}
+
+// Read a filler when filling the tests, a filled test otherwise, ahead of the test thread
+TestFileData prefetchFile(fs::path const& _file)
+{
+    if (test::Options::get().filltests)
+        return readFiller(_file);
+    TestFileData testData;
+    testData.data = readTestsToRun(_file);
+    return testData;
+}
+
 void joinThreads(vector<thread>& _threadVector, bool _all)
 {
     if (_all)
@@ -337,9 +398,33 @@ void TestSuite::runAllTestsInFolder(string const& _testFolder) const
     AbsoluteFillerPath fillerPath = getFullPathFiller(_testFolder);
     vector<fs::path> const files = test::getFiles(fillerPath.path(), {".json", ".yml"}, filter);
 
+    // Files that the test threads are going to read, in the order of the threads
+    vector<fs::path> prefetchFiles;
+    for (auto const& file : files)
+    {
+        string const stem = file.stem().string();
+        size_t const pos = stem.rfind(c_fillerPostf);
+        if (Options::get().filltests)
+        {
+            // Copier files are copied, not parsed
+            if (pos != string::npos && !Options::get().showhash && !fs::is_empty(file))
+                prefetchFiles.push_back(file);
+        }
+        else
+        {
+            size_t const namePos = pos != string::npos ? pos : stem.rfind(c_copierPostf);
+            fs::path const testFile =
+                getFullPath(_testFolder).path() / fs::path(stem.substr(0, namePos) + ".json");
+            if (namePos != string::npos && fs::exists(testFile) && !fs::is_empty(testFile))
+                prefetchFiles.push_back(testFile);
+        }
+    }
+
     // repeat this part for all connected clients
-    auto thisPart = [this, &files, &_testFolder]() {
+    auto thisPart = [this, &files, &prefetchFiles, &_testFolder]() {
         auto& testOutput = test::TestOutputHelper::get();
+        TestFilePrefetcher prefetcher(prefetchFiles, &prefetchFile,
+            max<size_t>(Options::get().threadCount / 2, 1), 2 * Options::get().threadCount);
         vector<thread> threadVector;
         testOutput.initTest(files.size());
         for (auto const& file : files)
@@ -364,7 +449,7 @@ void TestSuite::runAllTestsInFolder(string const& _testFolder) const
 
             if (threadVector.size() == maxAllowedThreads)
                 joinThreads(threadVector, false);
-            thread testThread(&TestSuite::executeTest, this, _testFolder, file);
+            thread testThread(&TestSuite::executeTest, this, _testFolder, file, &prefetcher);
             threadVector.push_back(std::move(testThread));
         }
         joinThreads(threadVector, true);
@@ -398,7 +483,8 @@ TestSuite::AbsoluteTestPath TestSuite::getFullPath(string const& _testFolder) co
     return TestSuite::AbsoluteTestPath(test::getTestPath() / suiteFolder().path() / _testFolder);
 }
 
-void TestSuite::executeTest(string const& _testFolder, fs::path const& _testFileName) const
+void TestSuite::executeTest(string const& _testFolder, fs::path const& _testFileName,
+    TestFilePrefetcher* _prefetcher) const
 {
     RPCSession::sessionStart(TestOutputHelper::getThreadID());
     TestOutputHelper::get().setCurrentTestFile(_testFileName);
@@ -449,8 +535,10 @@ void TestSuite::executeTest(string const& _testFolder, fs::path const& _testFile
         }
         else
         {
-            TestFileData testData = readTestFile(_testFileName);
-            removeComments(testData.data);
+            boost::optional<TestFileData> prefetched;
+            if (_prefetcher)
+                prefetched = _prefetcher->take(_testFileName);
+            TestFileData testData = prefetched ? std::move(*prefetched) : readFiller(_testFileName);
             opt.doFilling = true;
 
             try
@@ -458,7 +546,11 @@ void TestSuite::executeTest(string const& _testFolder, fs::path const& _testFile
                 DataObject output = doTests(testData.data, opt);
                 // Add client info for all of the tests in output
                 addClientInfo(output, boostRelativeTestPath, testData.hash);
-                writeFile(boostTestPath.path(), asBytes(output.asJson()));
+                // Tests of the file are serialized in parallel unless the test files are
+                // already filled on several threads (--jN), which keep the cores busy
+                size_t const writeThreads =
+                    Options::get().threadCount > 1 ? 1 : thread::hardware_concurrency();
+                dataobject::WriteDataObjectToFile(boostTestPath.path(), output, true, writeThreads);
             }
             catch (test::BaseEthException const&)
             {
@@ -480,7 +572,7 @@ void TestSuite::executeTest(string const& _testFolder, fs::path const& _testFile
         try
         {
             TestOutputHelper::get().setCurrentTestFile(boostTestPath.path());
-            executeFile(boostTestPath.path());
+            executeFile(boostTestPath.path(), _prefetcher);
         }
         catch (test::BaseEthException const&)
         {
@@ -496,10 +588,14 @@ void TestSuite::executeTest(string const& _testFolder, fs::path const& _testFile
     RPCSession::sessionEnd(TestOutputHelper::getThreadID(), RPCSession::SessionStatus::HasFinished);
 }
 
-void TestSuite::executeFile(boost::filesystem::path const& _file) const
+void TestSuite::executeFile(
+    boost::filesystem::path const& _file, TestFilePrefetcher* _prefetcher) const
 {
     TestSuiteOptions opt;
-    doTests(dataobject::ConvertJsoncppStringToData(dev::contentsString(_file)), opt);
+    boost::optional<TestFileData> prefetched;
+    if (_prefetcher)
+        prefetched = _prefetcher->take(_file);
+    doTests(prefetched ? prefetched->data : readTestsToRun(_file), opt);
 }
 
 }
@@ -26,12 +26,14 @@ using namespace dataobject;
 
 namespace test
 {
+class TestFilePrefetcher;
 
 class TestSuite
 {
 private:
-    // Execute Test.json file
-    void executeFile(boost::filesystem::path const& _file) const;
+    // Execute Test.json file (take it from _prefetcher if it is read in advance)
+    void executeFile(boost::filesystem::path const& _file,
+        TestFilePrefetcher* _prefetcher = nullptr) const;
     std::string checkFillerExistance(std::string const& _testFolder) const;
     struct BoostPath
     {
@@ -88,7 +90,9 @@ public:
 	void runAllTestsInFolder(std::string const& _testFolder) const;
 
 	// Execute Filler.json or Copier.json test file in a given folder
-	void executeTest(std::string const& _testFolder, boost::filesystem::path const& _jsonFileName) const;
+	// Files read in advance by _prefetcher are taken from it
+	void executeTest(std::string const& _testFolder, boost::filesystem::path const& _jsonFileName,
+		TestFilePrefetcher* _prefetcher = nullptr) const;
 
 	// Execute Test.json file
 	void runTestWithoutFiller(boost::filesystem::path const& _file) const;
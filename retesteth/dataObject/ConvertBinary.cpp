@@ -0,0 +1,235 @@
+#include <dataObject/ConvertBinary.h>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace dataobject
+{
+namespace
+{
+uint32_t const c_binaryVersion = 1;
+char const c_binaryMagic[] = "DOBJ";
+uint8_t const c_flagAutosort = 1;
+uint8_t const c_flagOverwrite = 2;
+
+class BinaryWriter
+{
+public:
+    BinaryWriter(std::string& _out) : m_out(_out) {}
+
+    void write(DataObject const& _data)
+    {
+        // key table goes first so the reader has it before the nodes
+        std::string nodes;
+        m_out.swap(nodes);
+        writeNode(_data);
+        m_out.swap(nodes);
+
+        m_out.append(c_binaryMagic, 4);
+        writeU32(c_binaryVersion);
+        writeU32(m_keys.size());
+        for (std::string const* key : m_keys)
+            writeString(*key);
+        m_out.append(nodes);
+    }
+
+private:
+    void writeU32(uint32_t _value)
+    {
+        for (size_t i = 0; i < 4; i++)
+            m_out.push_back(static_cast<char>(_value >> (8 * i)));
+    }
+
+    void writeString(std::string const& _str)
+    {
+        if (_str.size() > std::numeric_limits<uint32_t>::max())
+            throw DataObjectException() << "Error writing binary DataObject: string is too large!";
+        writeU32(_str.size());
+        m_out.append(_str);
+    }
+
+    uint32_t internKey(std::string const& _key)
+    {
+        if (_key.empty())
+            return 0;
+        auto const it = m_keyIds.find(_key);
+        if (it != m_keyIds.end())
+            return it->second;
+        uint32_t const id = m_keys.size() + 1;
+        m_keys.push_back(&m_keyIds.emplace(_key, id).first->first);
+        return id;
+    }
+
+    void writeNode(DataObject const& _data)
+    {
+        m_out.push_back(static_cast<char>(_data.type()));
+        m_out.push_back(static_cast<char>((_data.isAutosort() ? c_flagAutosort : 0) |
+                                          (_data.isOverwritable() ? c_flagOverwrite : 0)));
+        writeU32(internKey(_data.getKey()));
+        switch (_data.type())
+        {
+        case DataType::String:
+            writeString(_data.asString());
+            break;
+        case DataType::Integer:
+            writeU32(static_cast<uint32_t>(_data.asInt()));
+            break;
+        case DataType::Bool:
+            m_out.push_back(_data.asBool() ? 1 : 0);
+            break;
+        case DataType::Array:
+        case DataType::Object:
+            writeU32(_data.getSubObjects().size());
+            for (auto const& el : _data.getSubObjects())
+                writeNode(el);
+            break;
+        case DataType::Null:
+            break;
+        }
+    }
+
+    std::string& m_out;
+    std::unordered_map<std::string, uint32_t> m_keyIds;
+    std::vector<std::string const*> m_keys;  // pointers to m_keyIds keys in the order of ids
+};
+
+class BinaryReader
+{
+public:
+    BinaryReader(dev::ReadOnlyView const& _input, size_t _offset)
+      : m_input(_input), m_pos(_offset)
+    {}
+
+    DataObject read()
+    {
+        require(4);
+        if (std::memcmp(m_input.data() + m_pos, c_binaryMagic, 4) != 0)
+            throw error("not a binary DataObject");
+        m_pos += 4;
+        if (readU32() != c_binaryVersion)
+            throw error("unsupported version");
+
+        uint32_t const keyCount = readU32();
+        m_keys.reserve(keyCount);
+        for (uint32_t i = 0; i < keyCount; i++)
+            m_keys.push_back(readRange());
+
+        DataObject root;
+        readNode(root);
+        return root;
+    }
+
+private:
+    struct Range
+    {
+        size_t pos;
+        size_t size;
+    };
+
+    DataObjectException error(std::string const& _message) const
+    {
+        return DataObjectException() << "Error reading binary DataObject: " + _message + "!";
+    }
+
+    void require(size_t _size) const
+    {
+        if (m_input.size() < m_pos || m_input.size() - m_pos < _size)
+            throw error("unexpected end of data");
+    }
+
+    uint8_t readU8()
+    {
+        require(1);
+        return static_cast<uint8_t>(m_input.data()[m_pos++]);
+    }
+
+    uint32_t readU32()
+    {
+        require(4);
+        uint32_t value = 0;
+        for (size_t i = 0; i < 4; i++)
+            value |= uint32_t(static_cast<uint8_t>(m_input.data()[m_pos++])) << (8 * i);
+        return value;
+    }
+
+    Range readRange()
+    {
+        size_t const size = readU32();
+        require(size);
+        Range const range{m_pos, size};
+        m_pos += size;
+        return range;
+    }
+
+    void readNode(DataObject& _node)
+    {
+        uint8_t const type = readU8();
+        uint8_t const flags = readU8();
+        uint32_t const key = readU32();
+        if (key > m_keys.size())
+            throw error("key id out of the key table");
+        if (key)
+            _node.setKeyView(m_input, m_keys[key - 1].pos, m_keys[key - 1].size);
+
+        switch (type)
+        {
+        case DataType::String:
+        {
+            Range const value = readRange();
+            _node.setStringView(m_input, value.pos, value.size);
+            break;
+        }
+        case DataType::Integer:
+            _node.setInt(static_cast<int>(readU32()));
+            break;
+        case DataType::Bool:
+            _node.setBool(readU8() != 0);
+            break;
+        case DataType::Array:
+        case DataType::Object:
+        {
+            // make an empty container of the type, then read the elements in place
+            if (type == DataType::Object)
+                _node.addSubObject(DataObject());
+            else
+                _node.addArrayObject(DataObject());
+            std::vector<DataObject>& elements = _node.getSubObjectsUnsafe();
+            elements.pop_back();
+
+            uint32_t const count = readU32();
+            require(count);  // every node takes at least a byte
+            elements.reserve(count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                elements.push_back(DataObject());
+                readNode(elements.back());
+            }
+            break;
+        }
+        case DataType::Null:
+            break;
+        default:
+            throw error("unknown node type");
+        }
+        _node.setAutosort(flags & c_flagAutosort);
+        _node.setOverwrite(flags & c_flagOverwrite);
+    }
+
+    dev::ReadOnlyView const& m_input;
+    size_t m_pos;
+    std::vector<Range> m_keys;
+};
+}  // namespace
+
+std::string ConvertDataToBinary(DataObject const& _data)
+{
+    std::string out;
+    BinaryWriter(out).write(_data);
+    return out;
+}
+
+DataObject ConvertBinaryToData(dev::ReadOnlyView const& _input, size_t _offset)
+{
+    return BinaryReader(_input, _offset).read();
+}
+}
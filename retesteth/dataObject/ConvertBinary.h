@@ -0,0 +1,17 @@
+#pragma once
+#include <dataObject/DataObject.h>
+
+namespace dataobject
+{
+/// Compact binary form of DataObject used to cache parsed test files
+/// Little endian, every string and container is length prefixed and the keys are interned
+/// into a table at the beginning, so the data is read without any text parsing:
+///   "DOBJ" u32:version u32:keyCount (u32:size bytes)* node
+///   node: u8:type u8:flags u32:key (0 - no key, i - key i-1 of the table) payload
+///   payload: String u32:size bytes, Integer i32, Bool u8, Array/Object u32:count node*
+std::string ConvertDataToBinary(DataObject const& _data);
+
+/// Read DataObject written by ConvertDataToBinary at _offset of _input
+/// Keys and string values of the result are views into _input
+DataObject ConvertBinaryToData(dev::ReadOnlyView const& _input, size_t _offset = 0);
+}
@@ -1,5 +1,10 @@
 #include <dataObject/ConvertFile.h>
 #include <dataObject/Exception.h>
+#include <dataObject/StructuralIndex.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
 // Manually construct dataobject from file string content
 // bacuse Json::Reader::parse has a memory leak
 
@@ -7,296 +12,961 @@ namespace dataobject
 {
 string const errorPrefix = "Error parsing json: ";
 
-size_t stripSpaces(string const& _input, size_t _i)
+namespace
 {
-    size_t i = _i;
-    for (; i < _input.length(); i++)
+// Objects with more keys than this get a hash index to find duplicate keys
+size_t const c_keyIndexThreshold = 16;
+
+bool isTokenEnd(char _ch)
+{
+    switch (_ch)
     {
-        if (_input[i] == ' ' || _input[i] == '\n' || _input[i] == '\r' || _input[i] == '\t')
-            continue;
-        else
-            return i;
+    case ' ':
+    case '\n':
+    case '\r':
+    case '\t':
+    case '"':
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+    case ':':
+    case ',':
+        return true;
+    default:
+        return false;
     }
-    return i;
 }
 
-string parseKeyValue(string const& _input, size_t& _i)
+// Chars of the json input, either a std::string or a shared view
+class JsonText
 {
-    if (_i + 1 > _input.size())
-        throw DataObjectException() << errorPrefix + "reached EOF before reading char: `\"`";
-
-    size_t endPos = _input.find('"', _i + 1);
-    if (endPos != string::npos)
+public:
+    JsonText(char const* _data, size_t _size) : m_data(_data), m_size(_size) {}
+    char const* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    char operator[](size_t _pos) const { return m_data[_pos]; }
+    string substr(size_t _pos, size_t _count) const
+    {
+        _pos = std::min(_pos, m_size);
+        return string(m_data + _pos, std::min(_count, m_size - _pos));
+    }
+    bool equals(size_t _pos, size_t _count, string const& _str) const
     {
-        string key = _input.substr(_i + 1, endPos - _i - 1);
-        _i = endPos + 1;
-        return key;
+        return _count == _str.size() && std::memcmp(m_data + _pos, _str.data(), _count) == 0;
     }
+
+private:
+    char const* m_data;
+    size_t m_size;
+};
+
+DataObjectException jsonError(JsonText const& _input, size_t _pos, string const& _message)
+{
+    size_t const from = _pos > 40 ? _pos - 40 : 0;
+    return DataObjectException() << errorPrefix + _message + " around: " + _input.substr(from, 80);
+}
+
+// Make Null _node an empty object or array, keeping the key and flags
+void setContainerType(DataObject& _node, DataType _type)
+{
+    if (_type == DataType::Object)
+        _node.addSubObject(DataObject());
     else
-        throw DataObjectException() << errorPrefix + "not found key ending char: `\"`";
-    return string();
+        _node.addArrayObject(DataObject());
+    _node.getSubObjectsUnsafe().pop_back();
 }
 
-bool readBoolOrNull(string const& _input, size_t& _i, bool& _result, bool& _readNull)
+// Range of chars of the json input
+struct StringRange
 {
-    if (_i + 4 >= _input.size())
-        return false;
+    size_t pos;
+    size_t size;
+};
 
-    // true false
-    string text = _input.substr(_i, 4);
-    if (text == "null")
+// Hash and compare key ranges in place
+class KeyRangeHash
+{
+public:
+    KeyRangeHash(char const* _data) : m_data(_data) {}
+    size_t operator()(StringRange const& _key) const
     {
-        _i += 4;
-        _readNull = true;
-        return false;
+        // FNV-1a
+        size_t hash = 2166136261u;
+        for (char const* it = m_data + _key.pos; it != m_data + _key.pos + _key.size; it++)
+            hash = (hash ^ static_cast<unsigned char>(*it)) * 16777619u;
+        return hash;
     }
-    if (text == "true")
+
+private:
+    char const* m_data;
+};
+
+class KeyRangeEqual
+{
+public:
+    KeyRangeEqual(char const* _data) : m_data(_data) {}
+    bool operator()(StringRange const& _a, StringRange const& _b) const
     {
-        _result = true;
-        _i += 4;
-        return true;
+        return _a.size == _b.size && std::memcmp(m_data + _a.pos, m_data + _b.pos, _a.size) == 0;
     }
-    else if (text == "fals")
+
+private:
+    char const* m_data;
+};
+
+// Return the token that follows the json value starting at _token
+size_t skipValue(JsonText const& _input, std::vector<uint32_t> const& _index, size_t _token)
+{
+    string closing;  // expected closing brackets of the nested containers
+    size_t token = _token;
+    do
     {
-        if (_i + 5 < _input.size() && (_input[_i + 5] == 'e'))
+        if (token >= _index.size())
+            throw jsonError(_input, _input.size(), "unexpected end of json!");
+        char const ch = _input[_index[token]];
+        switch (ch)
         {
-            _i += 5;
-            _result = false;
-            return true;
+        case '{':
+            closing.push_back('}');
+            break;
+        case '[':
+            closing.push_back(']');
+            break;
+        case '}':
+        case ']':
+            if (closing.empty() || closing.back() != ch)
+                throw jsonError(_input, _index[token], string("unexpected '") + ch + "'!");
+            closing.pop_back();
+            break;
+        case ':':
+        case ',':
+            if (closing.empty())
+                throw jsonError(
+                    _input, _index[token], string("unexpected '") + ch + "' when expecting a value!");
+            break;
+        case '"':
+            token++;  // closing quote
+            break;
+        default:
+            break;
         }
-    }
-    return false;
+        token++;
+    } while (!closing.empty());
+    return token;
 }
 
-bool readDigit(string const& _input, size_t& _i, int& _result)
+// Value found in a number, true or null token
+struct LiteralValue
 {
-    bool readMinus = false;
-    char e = _input[_i];
-    if (e == '-')
-    {
-        readMinus = true;
-        _i++;
-    }
+    DataType type;
+    int intValue;
+};
 
-    bool digit = true;
-    string readNumber;
-    while (digit)
+// Return the end of the token that starts at _begin and is not a string or a structural char
+size_t literalEnd(JsonText const& _input, size_t _begin)
+{
+    size_t end = _begin;
+    while (end < _input.size() && !isTokenEnd(_input[end]))
+        end++;
+    return end;
+}
+
+// Read the chars [_begin, _end) of a literal token the way the previous parser did, filler hashes
+// (sourceHash) of the existing tests are made from its output: the chars are scanned for integers,
+// `true` and `null` and the rest is skipped, so `1.5` is read as 1 and 5 and `false` is not read
+// Return the position after the last value found
+size_t scanLiteral(
+    JsonText const& _input, size_t _begin, size_t _end, std::vector<LiteralValue>& _values)
+{
+    _values.clear();
+    size_t last = _begin;
+    size_t i = _begin;
+    while (i < _end)
     {
-        e = _input[_i];
-        if (e == '0' || e == '1' || e == '2' || e == '3' || e == '4' || e == '5' || e == '6' ||
-            e == '7' || e == '8' || e == '9')
+        size_t const sign = _input[i] == '-' ? i + 1 : i;
+        size_t digits = sign;
+        while (digits < _end && _input[digits] >= '0' && _input[digits] <= '9')
+            digits++;
+        if (digits != sign)
         {
-            readNumber += e;
-            _i++;
+            int const value = std::atoi(_input.substr(sign, digits - sign).c_str());
+            _values.push_back(LiteralValue{DataType::Integer, sign != i ? -value : value});
+            i = last = digits;
         }
-        else
+        else if (sign + 4 <= _end && sign + 4 < _input.size() && _input.equals(sign, 4, "null"))
+        {
+            _values.push_back(LiteralValue{DataType::Null, 0});
+            i = last = sign + 4;
+        }
+        else if (sign + 4 <= _end && sign + 4 < _input.size() && _input.equals(sign, 4, "true"))
         {
-            digit = false;
-            _i = stripSpaces(_input, _i);
+            _values.push_back(LiteralValue{DataType::Bool, 1});
+            i = last = sign + 4;
         }
+        else
+            i = sign + 1;
     }
-    if (readNumber.size())
+    return last;
+}
+
+void setLiteral(DataObject& _node, LiteralValue const& _value)
+{
+    if (_value.type == DataType::Integer)
+        _node.setInt(_value.intValue);
+    else if (_value.type == DataType::Bool)
+        _node.setBool(_value.intValue != 0);
+}
+
+// The previous parser read the json only if it did not end with a space, and then the '}' after
+// a member value it did not read (like `false`) closed the member, leaving the object open
+bool closesMemberValues(JsonText const& _input)
+{
+    if (_input.empty())
+        return false;
+    char const last = _input[_input.size() - 1];
+    return last != ' ' && last != '\n' && last != '\r' && last != '\t';
+}
+
+// Return true if the tokens [_begin, _end) have a member value without literals followed by '}'
+// or by a key, which could leave its object open (see closesMemberValues)
+bool hasUnreadMemberValue(
+    JsonText const& _input, std::vector<uint32_t> const& _index, size_t _begin, size_t _end)
+{
+    std::vector<LiteralValue> values;
+    for (size_t token = _begin; token < _end; token++)
     {
-        _result = std::atoi(readNumber.c_str());
-        if (readMinus)
-            _result *= -1;
-        return true;
+        size_t const begin = _index[token];
+        if (_input[begin] == '"')
+        {
+            token++;  // closing quote
+            continue;
+        }
+        if (isTokenEnd(_input[begin]) || token == 0 || _input[_index[token - 1]] != ':' ||
+            token + 1 == _index.size())
+            continue;
+        char const next = _input[_index[token + 1]];
+        bool const beforeKey =
+            next == '"' && token + 3 < _index.size() && _input[_index[token + 3]] == ':';
+        if ((next == '}' || beforeKey) &&
+            scanLiteral(_input, begin, literalEnd(_input, begin), values) == begin)
+            return true;
     }
     return false;
 }
 
-/// Convert Json object represented as string to DataObject
-DataObject ConvertJsoncppStringToData(
-    std::string const& _input, string const& _stopper, bool _autosort)
+/// Second stage of the json parser
+/// Construct DataObject walking the token positions found by BuildStructuralIndex
+/// If _source is set keys and string values of the result are views into it
+/// Members skipped by the options are stepped over by the index without creating DataObjects
+/// Json is read to the same DataObject as the previous parser read it, filler hashes (sourceHash)
+/// of the existing tests are made from its output (see readMemberLiteral, insertMembers)
+class JsonIndexParser
 {
-    std::vector<DataObject*> applyDepth;  // indexes at root array of objects that we are reading
-                                          // into
-    DataObject root;
-    root.setAutosort(_autosort);
-    DataObject* actualRoot = &root;
-    bool keyEncountered = false;
-    string debug = _input.substr(0, 40);
-    for (size_t i = 0; i < _input.length(); i++)
+public:
+    JsonIndexParser(JsonText const& _input, std::vector<uint32_t> const& _index,
+        dev::ReadOnlyView const* _source, JsonParseOptions const& _options)
+      : m_input(_input),
+        m_index(_index),
+        m_source(_source),
+        m_options(_options),
+        m_autosort(_options.autosort),
+        m_closeMembers(closesMemberValues(_input)),
+        m_token(0),
+        m_depth(0),
+        m_openObjects(0)
+    {}
+
+    DataObject parse()
     {
-        // std::cerr << root.asJson() << std::endl;
-        i = stripSpaces(_input, i);
-        if (i == _input.length())
-            throw DataObjectException() << errorPrefix + "unexpected end of json! around: " + debug;
+        DataObject root;
+        root.setAutosort(m_autosort);
+        if (m_input.empty())
+            return root;
 
-        if (i > 40)
-            debug = _input.substr(i - 40, 80);
+        char const first = current();
+        if (first != '{' && first != '[')
+            throw error("expected '{' or '[' at the beginning of json!");
+        if (parseValue(root, StringRange{0, 0}) && m_token != m_index.size())
+            throw error("expected end of json!");
+        return root;
+    }
 
-        if (_input[i] == '"')
-        {
-            DataObject obj;
-            string key = parseKeyValue(_input, i);
-            i = stripSpaces(_input, i);
-            if (_input.at(i) == ':')
-            {
-                if (keyEncountered)
-                    throw DataObjectException() << errorPrefix +
-                                                       "attempt to set key multiple times! (like "
-                                                       "\"key\" : \"key\" : \"value\") around: " +
-                                                       debug;
-
-                keyEncountered = true;
-                if (actualRoot->type() == DataType::Array)
-                    throw DataObjectException()
-                        << errorPrefix +
-                               "array could not have elements with keys! around: " + debug;
-                obj.setKey(key);
-                bool replaceKey = false;
-                size_t keyPosExpected = _autosort ?
-                        max(0, (int)findOrderedKeyPosition(key, actualRoot->getSubObjects()) - 1) : 0;
-                for (size_t objI = keyPosExpected; objI < actualRoot->getSubObjects().size(); objI++)
-                {
-                    if (actualRoot->getSubObjects().at(objI).getKey() == key)
-                    {
-                        replaceKey = true;
-                        applyDepth.push_back(actualRoot);
-                        actualRoot = &actualRoot->getSubObjectsUnsafe().at(objI);
-                        actualRoot->clearSubobjects();
-                        break;
-                    }
-                }
+    /// Read the json value starting at _token into _node with the key _key
+    /// Return the token after the value
+    size_t parseAt(size_t _token, DataObject& _node, StringRange const& _key)
+    {
+        m_token = _token;
+        m_depth = 1;
+        m_openObjects = 0;
+        parseValue(_node, _key);
+        return m_token;
+    }
 
-                if (replaceKey)
-                    continue;
-                applyDepth.push_back(actualRoot);  // remember the header
-                actualRoot = &actualRoot->addSubObject(obj);
-                actualRoot->setAutosort(_autosort);
-                continue;
+    /// Members with the keys _keys are sorted once the object is read instead of inserting every
+    /// key in order. Elements are moved into the new vector because DataObject::operator= keeps
+    /// the key of a Null. _capacity is the capacity the previous parser started the object with
+    void sortMembers(std::vector<DataObject>& _members, StringRange const* _keys, size_t _capacity)
+    {
+        for (auto const& member : _members)
+            if (member.type() == DataType::Null)
+            {
+                insertMembers(_members, _keys, _capacity);
+                return;
             }
+
+        auto const orderLess = [this, _keys](size_t _a, size_t _b) {
+            return keyLess(_keys[_a], _keys[_b]);
+        };
+        m_order.resize(_members.size());
+        for (size_t i = 0; i < m_order.size(); i++)
+            m_order.at(i) = i;
+        if (std::is_sorted(m_order.begin(), m_order.end(), orderLess))
+            return;
+
+        std::sort(m_order.begin(), m_order.end(), orderLess);
+        std::vector<DataObject> sorted;
+        sorted.reserve(_members.size());
+        for (size_t i : m_order)
+            sorted.push_back(std::move(_members.at(i)));
+        _members.swap(sorted);
+    }
+
+private:
+    typedef std::unordered_map<StringRange, size_t, KeyRangeHash, KeyRangeEqual> KeyIndex;
+
+    // Member of the object made by insertMembers: the key of one member and the value of another
+    struct Slot
+    {
+        size_t key;
+        size_t value;
+    };
+
+    DataObjectException error(string const& _message) const
+    {
+        return jsonError(
+            m_input, m_token < m_index.size() ? m_index[m_token] : m_input.size(), _message);
+    }
+
+    char current() const
+    {
+        if (m_token == m_index.size())
+            throw error("unexpected end of json!");
+        return m_input[m_index[m_token]];
+    }
+
+    char next() const
+    {
+        return m_token + 1 < m_index.size() ? m_input[m_index[m_token + 1]] : '\0';
+    }
+
+    /// True at the end of json if objects were left open by readMemberLiteral
+    bool atEndOfOpenObjects() const { return m_openObjects > 0 && m_token == m_index.size(); }
+
+    /// Read json value at the current token into _node of type Null
+    /// Return false if the reading was stopped at one of the stop keys
+    bool parseValue(DataObject& _node, StringRange const& _key)
+    {
+        switch (current())
+        {
+        case '{':
+            setContainerType(_node, DataType::Object);
+            return parseObject(_node, _key);
+        case '[':
+            setContainerType(_node, DataType::Array);
+            return parseArray(_node, _key);
+        case '"':
+        {
+            StringRange const value = readString();
+            if (m_source)
+                _node.setStringView(*m_source, value.pos, value.size);
             else
+                _node.setString(m_input.substr(value.pos, value.size));
+            return true;
+        }
+        case '}':
+        case ']':
+        case ':':
+        case ',':
+            throw error(string("unexpected '") + current() + "' when expecting a value!");
+        default:
+            return readMemberLiteral(_node, _key);
+        }
+    }
+
+    bool parseObject(DataObject& _object, StringRange const& _key)
+    {
+        // the previous parser copied the objects into arrays, others were made with capacity 1
+        size_t const capacity = m_token > 0 && m_input[m_index[m_token - 1]] != ':' ? 0 : 1;
+        // keys of the object members are on top of m_keys while the object is read
+        size_t const firstKey = m_keys.size();
+        m_depth++;
+        bool const keepReading = readObjectMembers(_object, _key, firstKey);
+        m_depth--;
+        if (m_autosort && _object.type() == DataType::Object)
+            sortMembers(_object.getSubObjectsUnsafe(), m_keys.data() + firstKey, capacity);
+        m_keys.resize(firstKey);
+        return keepReading;
+    }
+
+    bool readObjectMembers(DataObject& _object, StringRange const& _objectKey, size_t _firstKey)
+    {
+        m_token++;
+        if (current() == '}')
+            return closeContainer(_objectKey);
+
+        KeyIndex keyIndex(0, KeyRangeHash(m_input.data()), KeyRangeEqual(m_input.data()));
+        while (true)
+        {
+            if (current() == ']')
+                throw error("expected '}' closing the object!");
+            if (current() != '"')
             {
-                keyEncountered = false;
-                if (actualRoot->type() == DataType::Array)
-                {
-                    actualRoot->addArrayObject(DataObject(key));
-                    if (_input.at(i) != ',')
-                        i--;  // because cycle iteration we need to process ending clouse
-                    continue;
-                }
-                else
-                    actualRoot->setString(key);
-                if (_input.at(i) != ',')
-                    i--;  // because cycle iteration we need to process ending clouse
-                actualRoot = applyDepth.at(applyDepth.size() - 1);
-                applyDepth.pop_back();
+                size_t const begin = m_index[m_token];
+                if (m_openObjects == 0 ||
+                    !m_input.equals(begin, literalEnd(m_input, begin) - begin, "null"))
+                    throw error("expected key string in object!");
+                // `null` in place of a key is read as the value of the open object
+                _object.clearSubobjects();
+                m_openObjects--;
+                m_token++;
+                return true;
+            }
+            StringRange const key = readString();
+            if (current() != ':')
+                throw error("expected ':' after the key `" + m_input.substr(key.pos, key.size) + "`!");
+            m_token++;
+
+            if (m_options.skip.skips(m_input.data() + key.pos, key.size, m_depth - 1))
+                m_token = skipValue(m_input, m_index, m_token);
+            else if (!parseValue(addMember(_object, key, keyIndex, _firstKey), key))
+                return false;
+
+            if (atEndOfOpenObjects())
+                return true;
+            switch (current())
+            {
+            case ',':
+                // a trailing comma is allowed
+                m_token++;
+                if (atEndOfOpenObjects())
+                    return true;
+                if (current() == '}')
+                    return closeContainer(_objectKey);
                 continue;
+            case '}':
+                return closeContainer(_objectKey);
+            case '"':
+                continue;  // a missing comma is allowed
+            case ']':
+                throw error("expected '}' closing the object!");
+            case ':':
+                throw error("attempt to set key multiple times! (like \"key\" : \"key\" : \"value\")");
+            default:
+                throw error("expected ',' or '}' after the object member!");
             }
         }
+    }
+
+    bool parseArray(DataObject& _array, StringRange const& _key)
+    {
+        m_depth++;
+        bool const keepReading = readArrayElements(_array, _key);
+        m_depth--;
+        return keepReading;
+    }
 
-        keyEncountered = false;
-        if (_input[i] == '{')
+    bool readArrayElements(DataObject& _array, StringRange const& _key)
+    {
+        m_token++;
+        if (current() == ']')
+            return closeContainer(_key);
+
+        while (true)
         {
-            if (actualRoot->type() == DataType::Array || actualRoot->type() == DataType::Object)
+            if (!isTokenEnd(current()))
+                readElementLiteral(_array);
+            else
             {
-                DataObject newObj(DataType::Object);
-                applyDepth.push_back(actualRoot);
-                actualRoot = &actualRoot->addSubObject(newObj);
-                actualRoot->setAutosort(_autosort);
-                continue;
+                std::vector<DataObject>& elements = _array.getSubObjectsUnsafe();
+                elements.push_back(DataObject());
+                elements.back().setAutosort(m_autosort);
+                if (!parseValue(elements.back(), StringRange{0, 0}))
+                    return false;
             }
 
-            actualRoot->addSubObject(DataObject());
-            actualRoot->getSubObjectsUnsafe().pop_back();
-            continue;
-        }
-        if (_input[i] == '[')
-        {
-            if (actualRoot->type() == DataType::Array || actualRoot->type() == DataType::Object)
+            if (atEndOfOpenObjects())
+                return true;
+            switch (current())
             {
-                DataObject* newObj = &actualRoot->addSubObject(DataObject(DataType::Array));
-                newObj->setAutosort(_autosort);
+            case ',':
+                // a trailing comma is allowed
+                m_token++;
+                if (atEndOfOpenObjects())
+                    return true;
+                if (current() == ']')
+                    return closeContainer(_key);
                 continue;
+            case ']':
+                return closeContainer(_key);
+            case '}':
+                throw error("expected ']' closing the array!");
+            case ':':
+                throw error("array could not have elements with keys!");
+            default:
+                continue;  // a missing comma is allowed
             }
-
-            actualRoot->addArrayObject(DataObject());
-            actualRoot->getSubObjectsUnsafe().pop_back();
-            continue;
         }
+    }
+
+    bool closeContainer(StringRange const& _key)
+    {
+        m_token++;
+        for (auto const& stopKey : m_options.stopKeys)
+            if (m_input.equals(_key.pos, _key.size, stopKey))
+                return false;
+        return true;
+    }
+
+    bool keyLess(StringRange const& _a, StringRange const& _b) const
+    {
+        int const cmp =
+            std::memcmp(m_input.data() + _a.pos, m_input.data() + _b.pos, std::min(_a.size, _b.size));
+        return cmp < 0 || (cmp == 0 && _a.size < _b.size);
+    }
 
-        if (_input[i] == ']' || _input[i] == '}')
+    /// Sort _members like the previous parser did: it inserted every member at its position with
+    /// vector::insert, which shifts the members with DataObject::operator=, and that keeps the key
+    /// of a Null member it assigns to. So a null member takes the value before it and the key
+    /// it had is lost, this is replayed here when a member is null
+    void insertMembers(
+        std::vector<DataObject>& _members, StringRange const* _keys, size_t _capacity)
+    {
+        m_slots.clear();
+        size_t capacity = _capacity;
+        for (size_t member = 0; member < _members.size(); member++)
         {
-            if (actualRoot->type() == DataType::Array && _input.at(i) != ']')
-                throw DataObjectException() << "expected ']' closing the array! around: " + debug;
-            if (actualRoot->type() == DataType::Object && _input.at(i) != '}')
+            size_t const pos = orderedPosition(_keys, _keys[member]);
+            if (pos == m_slots.size() || m_slots.size() == capacity)
             {
-                std::cerr << _input << std::endl;
-                throw DataObjectException() << "expected '}' closing the object! around: " + debug;
+                // the vector is reallocated or appended, no member is assigned
+                if (m_slots.size() == capacity)
+                    capacity += std::max(capacity, size_t(1));
+                m_slots.insert(m_slots.begin() + pos, Slot{member, member});
+                continue;
             }
-
-            if (!_stopper.empty() && actualRoot->getKey() == _stopper)
-                return root;
-
-            if (applyDepth.size() == 0)
+            m_slots.push_back(m_slots.back());
+            for (size_t i = m_slots.size() - 2; i > pos; i--)
             {
-                i++;
-                i = stripSpaces(_input, i);
-                if (i != _input.length())
-                    throw DataObjectException() << errorPrefix + "expected end of json!";
-                return root;
+                if (_members.at(m_slots.at(i).value).type() == DataType::Null)
+                    m_slots.at(i).value = m_slots.at(i - 1).value;
+                else
+                    m_slots.at(i) = m_slots.at(i - 1);
             }
+            m_slots.at(pos) = Slot{member, member};
+        }
+
+        std::vector<DataObject> inserted;
+        inserted.reserve(m_slots.size());
+        for (Slot const& slot : m_slots)
+        {
+            inserted.push_back(_members.at(slot.value));
+            StringRange const& key = _keys[slot.key];
+            if (m_source)
+                inserted.back().setKeyView(*m_source, key.pos, key.size);
             else
-            {
-                actualRoot = applyDepth.at(applyDepth.size() - 1);
-                applyDepth.pop_back();
-                if (i + 1 < _input.length())
+                inserted.back().setKey(m_input.substr(key.pos, key.size));
+        }
+        _members.swap(inserted);
+    }
+
+    /// Position of _key in m_slots found the way findOrderedKeyPosition does
+    size_t orderedPosition(StringRange const* _keys, StringRange const& _key) const
+    {
+        if (m_slots.empty())
+            return 0;
+        size_t step = m_slots.size() / 2;
+        size_t guess = step;
+        while (step > 0)
+        {
+            step = step / 2;
+            if (keyLess(_key, _keys[m_slots.at(guess).key]))
+                guess -= std::max(step, size_t(1));
+            else
+                guess += std::max(step, size_t(1));
+        }
+        if (guess == m_slots.size())
+            return guess;
+        guess = guess > 5 ? guess - 5 : 0;
+        while (guess < m_slots.size() && !keyLess(_key, _keys[m_slots.at(guess).key]))
+            guess++;
+        return guess;
+    }
+
+    /// Find the member _key in _object or add a new one
+    /// Existing member is cleared so the last value of the duplicated key is taken
+    DataObject& addMember(
+        DataObject& _object, StringRange const& _key, KeyIndex& _keyIndex, size_t _firstKey)
+    {
+        std::vector<DataObject>& members = _object.getSubObjectsUnsafe();
+        if (_keyIndex.empty() && members.size() >= c_keyIndexThreshold)
+            for (size_t i = 0; i < members.size(); i++)
+                _keyIndex.emplace(m_keys.at(_firstKey + i), i);
+
+        if (_keyIndex.empty())
+        {
+            KeyRangeEqual const equal(m_input.data());
+            for (size_t i = 0; i < members.size(); i++)
+                if (equal(m_keys.at(_firstKey + i), _key))
                 {
-                    if (_input[i + 1] == ',')
-                        i++;
-                    if (_input[i + 1] == ':')
-                        throw DataObjectException()
-                            << errorPrefix +
-                                   "unexpected ':' after closing an object/array! around: " + debug;
+                    members.at(i).clearSubobjects();
+                    return members.at(i);
                 }
-                continue;
+        }
+        else
+        {
+            KeyIndex::const_iterator it = _keyIndex.find(_key);
+            if (it != _keyIndex.end())
+            {
+                members.at(it->second).clearSubobjects();
+                return members.at(it->second);
             }
+            _keyIndex.emplace(_key, members.size());
         }
 
-        if (_input.at(i) == ',')
-            throw DataObjectException()
-                << errorPrefix + "unhendled ',' when parsing json around: " + debug;
-        if (_input.at(i) == ':')
-            throw DataObjectException()
-                << errorPrefix + "unhendled ':' when parsing json around: " + debug;
-
-        int resInt = 0;
-        bool resBool = false;
-        bool isReadBool = false;
-        bool isReadNull = false;
-        bool isReadDigit = readDigit(_input, i, resInt);
-        if (!isReadDigit)
-            isReadBool = readBoolOrNull(_input, i, resBool, isReadNull);
-
-        if (isReadDigit || isReadBool || isReadNull)
+        m_keys.push_back(_key);
+        members.push_back(DataObject());
+        DataObject& member = members.back();
+        if (m_source)
+            member.setKeyView(*m_source, _key.pos, _key.size);
+        else
+            member.setKey(m_input.substr(_key.pos, _key.size));
+        member.setAutosort(m_autosort);
+        return member;
+    }
+
+    StringRange readString()
+    {
+        if (m_token + 1 == m_index.size())
+            throw error("not found string ending char: `\"`");
+        size_t const begin = m_index[m_token] + 1;
+        size_t const end = m_index[m_token + 1];
+        m_token += 2;
+        return StringRange{begin, end - begin};
+    }
+
+    DataObjectException literalError(size_t _begin, size_t _end) const
+    {
+        return error("unexpected token `" + m_input.substr(_begin, _end - _begin) + "`!");
+    }
+
+    /// Read the number, true, false or null member value _member with the key _key
+    /// A token without literals is skipped. If it is followed by '}' or by a key, the member is
+    /// closed by that '}' or the members after it are read into the member, leaving the object
+    /// of the member open (see closesMemberValues)
+    /// Return false if the reading was stopped at one of the stop keys
+    bool readMemberLiteral(DataObject& _member, StringRange const& _key)
+    {
+        size_t const begin = m_index[m_token];
+        size_t const end = literalEnd(m_input, begin);
+        size_t const last = scanLiteral(m_input, begin, end, m_literals);
+        char const following = next();
+        bool const beforeKey = following == '"' && m_token + 3 < m_index.size() &&
+                               m_input[m_index[m_token + 3]] == ':';
+        bool const isFalse = m_input.equals(begin, end - begin, "false");
+        if (m_literals.size() == 1 && (last == end || following != ','))
+            setLiteral(_member, m_literals.at(0));
+        else if (!m_literals.empty())
+            throw literalError(begin, end);
+        else if (m_closeMembers && following == '}')
+        {
+            m_openObjects++;
+            m_token++;
+            return closeContainer(_key);
+        }
+        else if (m_closeMembers && beforeKey)
         {
-            if (actualRoot->type() == DataType::Array)
+            m_openObjects++;
+            setContainerType(_member, DataType::Object);
+            return parseObject(_member, _key);
+        }
+        else if (isFalse && (following == ',' || following == '}' || beforeKey))
+            _member.setBool(false);
+        else if (following == ',' || following == '}' || following == ']' || following == ':' ||
+                 following == '\0')
+            throw literalError(begin, end);
+        else
+        {
+            m_token++;
+            return parseValue(_member, _key);
+        }
+        m_token++;
+        return true;
+    }
+
+    /// Read the number, true, false or null array element into _array
+    /// A token can have several literals, like 1 and 5 in `1.5`
+    /// A token without literals is skipped
+    void readElementLiteral(DataObject& _array)
+    {
+        size_t const begin = m_index[m_token];
+        size_t const end = literalEnd(m_input, begin);
+        size_t const last = scanLiteral(m_input, begin, end, m_literals);
+        if (m_literals.empty())
+        {
+            if (next() != ',')
             {
-                if (isReadDigit)
-                    actualRoot->addArrayObject(DataObject(resInt));
-                else if (isReadBool)
-                    actualRoot->addArrayObject(DataObject(DataType::Bool, resBool));
-                else
-                    actualRoot->addArrayObject(DataObject());
+                m_token++;
+                return;
             }
-            else
+            if (!m_input.equals(begin, end - begin, "false"))
+                throw literalError(begin, end);
+            m_literals.push_back(LiteralValue{DataType::Bool, 0});
+        }
+        else if (last != end && next() == ',')
+            throw literalError(begin, end);
+
+        std::vector<DataObject>& elements = _array.getSubObjectsUnsafe();
+        for (auto const& value : m_literals)
+        {
+            elements.push_back(DataObject());
+            elements.back().setAutosort(m_autosort);
+            setLiteral(elements.back(), value);
+        }
+        m_token++;
+    }
+
+    JsonText const m_input;
+    std::vector<uint32_t> const& m_index;
+    dev::ReadOnlyView const* m_source;  // not set when strings are copied
+    JsonParseOptions const& m_options;
+    bool m_autosort;
+    bool m_closeMembers;  // see closesMemberValues
+    size_t m_token;
+    size_t m_depth;  // number of containers being read
+    size_t m_openObjects;  // number of objects left open by readMemberLiteral
+    std::vector<StringRange> m_keys;  // keys of the members of objects being read
+    std::vector<size_t> m_order;
+    std::vector<Slot> m_slots;
+    std::vector<LiteralValue> m_literals;
+};
+
+// Record the key tokens of the members of json object starting at _token
+// Return the token that follows the object
+size_t readMemberTokens(JsonText const& _input, std::vector<uint32_t> const& _index, size_t _token,
+    std::vector<size_t>& _keyTokens)
+{
+    auto const charAt = [&_input, &_index](size_t _t) -> char {
+        if (_t >= _index.size())
+            throw jsonError(_input, _input.size(), "unexpected end of json!");
+        return _input[_index[_t]];
+    };
+
+    if (charAt(_token) != '{')
+        throw jsonError(_input, _index[_token], "expected '{' opening the object!");
+    size_t token = _token + 1;
+    if (charAt(token) == '}')
+        return token + 1;
+    while (true)
+    {
+        if (charAt(token) != '"' || token + 1 == _index.size())
+            throw jsonError(_input, _index[token], "expected key string in object!");
+        _keyTokens.push_back(token);
+        if (charAt(token + 2) != ':')
+            throw jsonError(_input, _index[token], "expected ':' after the key!");
+        token = skipValue(_input, _index, token + 3);
+        switch (charAt(token))
+        {
+        case ',':
+            // a trailing comma is allowed
+            token++;
+            if (charAt(token) == '}')
+                return token + 1;
+            continue;
+        case '}':
+            return token + 1;
+        case '"':
+            continue;  // a missing comma is allowed
+        default:
+            throw jsonError(_input, _index[token], "expected ',' or '}' after the object member!");
+        }
+    }
+}
+
+StringRange keyRange(std::vector<uint32_t> const& _index, size_t _keyToken)
+{
+    return StringRange{_index[_keyToken] + 1, _index[_keyToken + 1] - _index[_keyToken] - 1};
+}
+
+DataObject parseJson(
+    JsonText const& _input, dev::ReadOnlyView const* _source, JsonParseOptions const& _options)
+{
+    std::vector<uint32_t> index;
+    BuildStructuralIndex(_input.data(), _input.size(), index);
+    return JsonIndexParser(_input, index, _source, _options).parse();
+}
+
+JsonParseOptions makeOptions(string const& _stopper, bool _autosort)
+{
+    JsonParseOptions options;
+    options.autosort = _autosort;
+    if (!_stopper.empty())
+        options.stopKeys.push_back(_stopper);
+    return options;
+}
+}  // namespace
+
+/// Convert Json object represented as string to DataObject
+DataObject ConvertJsoncppStringToData(
+    std::string const& _input, string const& _stopper, bool _autosort)
+{
+    return parseJson(
+        JsonText(_input.data(), _input.size()), nullptr, makeOptions(_stopper, _autosort));
+}
+
+/// Convert Json object to DataObject in view mode
+DataObject ConvertJsoncppStringToData(
+    dev::ReadOnlyView const& _input, string const& _stopper, bool _autosort)
+{
+    return ConvertJsoncppStringToData(_input, makeOptions(_stopper, _autosort));
+}
+
+/// Convert Json object to DataObject in view mode skipping the members filtered by _options
+DataObject ConvertJsoncppStringToData(
+    dev::ReadOnlyView const& _input, JsonParseOptions const& _options)
+{
+    return parseJson(JsonText(_input.data(), _input.size()), &_input, _options);
+}
+
+LazyJsonDocument::LazyJsonDocument(dev::ReadOnlyView const& _input, bool _autosort)
+  : m_input(_input), m_autosort(_autosort)
+{
+    JsonText const text(m_input.data(), m_input.size());
+    std::vector<size_t> keyTokens;
+    BuildStructuralIndex(text.data(), text.size(), m_index);
+    if (readMemberTokens(text, m_index, 0, keyTokens) != m_index.size())
+        throw jsonError(text, text.size(), "expected end of json!");
+
+    // The object left open by a member value (see closesMemberValues) takes the members after it,
+    // such member is read past its value
+    size_t openKeyToken = m_index.size();
+    if (closesMemberValues(text))
+    {
+        JsonParseOptions const options;
+        JsonIndexParser parser(text, m_index, &m_input, options);
+        for (size_t i = 0; i < keyTokens.size(); i++)
+        {
+            size_t const valueToken = keyTokens.at(i) + 3;
+            size_t const end = skipValue(text, m_index, valueToken);
+            if (!hasUnreadMemberValue(text, m_index, valueToken, end))
+                continue;
+            DataObject value;
+            if (parser.parseAt(valueToken, value, keyRange(m_index, keyTokens.at(i))) != end)
             {
-                if (isReadDigit)
-                    actualRoot->setInt(resInt);
-                else if (isReadBool)
-                    actualRoot->setBool(resBool);
-                else
-                    actualRoot->clearSubobjects();
-                actualRoot = applyDepth.at(applyDepth.size() - 1);
-                applyDepth.pop_back();
+                openKeyToken = keyTokens.at(i);
+                keyTokens.resize(i + 1);
+                break;
             }
-            if (_input[i] != ',')
-                i--;
-            continue;
         }
     }
+
+    // Duplicated key takes the place of the first occurrence and the last value
+    for (size_t keyToken : keyTokens)
+    {
+        StringRange const key = keyRange(m_index, keyToken);
+        string name = text.substr(key.pos, key.size);
+        auto const existing = m_keyPositions.find(name);
+        size_t const position = existing != m_keyPositions.end() ? existing->second : m_keys.size();
+        if (existing != m_keyPositions.end())
+            m_keyTokens.at(position) = keyToken;
+        else
+        {
+            m_keyPositions.emplace(name, position);
+            m_keys.push_back(std::move(name));
+            m_keyTokens.push_back(keyToken);
+        }
+        if (keyToken == openKeyToken)
+            m_openMember = position;
+    }
+}
+
+bool LazyJsonDocument::count(std::string const& _key) const
+{
+    return m_keyPositions.count(_key);
+}
+
+DataObject LazyJsonDocument::getMember(std::string const& _key, std::string const& _subKey) const
+{
+    auto const position = m_keyPositions.find(_key);
+    if (position == m_keyPositions.end())
+        throw DataObjectException() << "LazyJsonDocument does not have a key: " + _key;
+
+    JsonParseOptions options;
+    options.autosort = m_autosort;
+    size_t const keyToken = m_keyTokens.at(position->second);
+    StringRange const key = keyRange(m_index, keyToken);
+    DataObject member;
+    member.setKeyView(m_input, key.pos, key.size);
+    member.setAutosort(m_autosort);
+
+    JsonText const text(m_input.data(), m_input.size());
+    JsonIndexParser parser(text, m_index, &m_input, options);
+    size_t const valueToken = keyToken + 3;
+    if (_subKey.empty() || text[m_index[valueToken]] != '{')
+    {
+        parser.parseAt(valueToken, member, key);
+        return member;
+    }
+    if (position->second == m_openMember)
+    {
+        // the member keys are known once it is read
+        parser.parseAt(valueToken, member, key);
+        member.removeFilteredKeys(KeyFilter().includeTopLevel(_subKey));
+        return member;
+    }
+
+    setContainerType(member, DataType::Object);
+    std::vector<size_t> subKeyTokens;
+    readMemberTokens(text, m_index, valueToken, subKeyTokens);
+    for (auto it = subKeyTokens.rbegin(); it != subKeyTokens.rend(); it++)
+    {
+        StringRange const subKey = keyRange(m_index, *it);
+        if (!text.equals(subKey.pos, subKey.size, _subKey))
+            continue;
+        std::vector<DataObject>& members = member.getSubObjectsUnsafe();
+        members.push_back(DataObject());
+        members.back().setKeyView(m_input, subKey.pos, subKey.size);
+        members.back().setAutosort(m_autosort);
+        parser.parseAt(*it + 3, members.back(), subKey);
+        break;
+    }
+    return member;
+}
+
+DataObject LazyJsonDocument::getMembers(std::function<bool(std::string const&)> const& _filter) const
+{
+    JsonParseOptions options;
+    options.autosort = m_autosort;
+    DataObject root;
+    root.setAutosort(m_autosort);
+    setContainerType(root, DataType::Object);
+    JsonIndexParser parser(JsonText(m_input.data(), m_input.size()), m_index, &m_input, options);
+    std::vector<DataObject>& members = root.getSubObjectsUnsafe();
+    std::vector<StringRange> keys;
+    for (size_t i = 0; i < m_keys.size(); i++)
+    {
+        if (_filter && !_filter(m_keys.at(i)))
+            continue;
+        size_t const keyToken = m_keyTokens.at(i);
+        keys.push_back(keyRange(m_index, keyToken));
+        members.push_back(DataObject());
+        members.back().setKeyView(m_input, keys.back().pos, keys.back().size);
+        members.back().setAutosort(m_autosort);
+        parser.parseAt(keyToken + 3, members.back(), keys.back());
+    }
+    if (m_autosort)
+        parser.sortMembers(members, keys.data(), 1);
     return root;
 }
 }
@@ -1,9 +1,66 @@
 #pragma once
 #include <dataObject/DataObject.h>
+#include <dataObject/KeyFilter.h>
+#include <functional>
+#include <unordered_map>
 
 namespace dataobject
 {
+/// Version of the json and yaml reading into DataObject
+/// Increase it with every change of the parser output, so that cached test files are read again
+uint32_t const c_parserVersion = 2;
+
+/// Options of the json to DataObject conversion
+struct JsonParseOptions
+{
+    bool autosort = false;
+    /// Members dropped by the parser together with their subtrees
+    KeyFilter skip;
+    /// Reading stops once an object or array under one of these keys is read
+    std::vector<std::string> stopKeys;
+};
+
 /// Convert Json object represented as string to DataObject
 DataObject ConvertJsoncppStringToData(
     std::string const& _input, string const& _stopper = string(), bool _setAutosort = false);
+
+/// Convert Json object to DataObject without copying the strings (view mode)
+/// Keys and string values of the result refer to _input, which is kept alive by the result,
+/// and are copied only when accessed as std::string
+DataObject ConvertJsoncppStringToData(dev::ReadOnlyView const& _input,
+    string const& _stopper = string(), bool _setAutosort = false);
+DataObject ConvertJsoncppStringToData(
+    dev::ReadOnlyView const& _input, JsonParseOptions const& _options);
+
+/// Json object with the top level members indexed but not parsed
+/// Members are converted to DataObject (in view mode) only when requested,
+/// so reading a part of a big test file skips the parsing of the rest
+class LazyJsonDocument
+{
+public:
+    LazyJsonDocument(dev::ReadOnlyView const& _input, bool _autosort = false);
+
+    /// Top level keys in the document order
+    std::vector<std::string> const& getKeys() const { return m_keys; }
+    bool count(std::string const& _key) const;
+
+    /// Parse the top level member _key
+    /// If _subKey is set and the member is an object, parse only its member _subKey
+    DataObject getMember(std::string const& _key, std::string const& _subKey = std::string()) const;
+
+    /// Parse the object of top level members whose key is accepted by _filter (all if not set)
+    DataObject getMembers(
+        std::function<bool(std::string const&)> const& _filter = std::function<bool(std::string const&)>()) const;
+
+private:
+    dev::ReadOnlyView m_input;
+    bool m_autosort;
+    std::vector<uint32_t> m_index;
+    std::vector<std::string> m_keys;
+    std::vector<size_t> m_keyTokens;  // index token of the key of m_keys member
+    std::unordered_map<std::string, size_t> m_keyPositions;
+    /// Position in m_keys of the member read till the end of the document, the object left open
+    /// by its value takes the members after it
+    size_t m_openMember = size_t(-1);
+};
 }
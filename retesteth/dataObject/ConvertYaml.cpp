@@ -1,4 +1,8 @@
 #include <dataObject/ConvertYaml.h>
+#include <yaml-cpp/eventhandler.h>
+#include <istream>
+#include <map>
+#include <streambuf>
 
 namespace dataobject
 {
@@ -24,40 +28,216 @@ std::string yamlTypeAsString(YAML::NodeType::value _type)
     return "";
 }
 
-DataObject ConvertYamlToData(YAML::Node const& _node)
+namespace
 {
-    if (_node.IsNull())
-        return DataObject(DataType::Null);
+// Read only stream buffer over the chars of the view
+class ViewStreamBuf : public std::streambuf
+{
+public:
+    ViewStreamBuf(dev::ReadOnlyView const& _input)
+    {
+        char* data = const_cast<char*>(_input.data());
+        setg(data, data, data + _input.size());
+    }
+};
 
-    if (_node.IsScalar())
+// Build DataObject from the yaml parser events the same way YAML::Node would be converted
+// Every map and sequence is built on the stack and added to its parent when it ends
+class YamlDataBuilder : public YAML::EventHandler
+{
+public:
+    YamlDataBuilder(KeyFilter const& _skip) : m_skip(_skip) {}
+    DataObject const& result() const { return m_result; }
+
+    void OnDocumentStart(YAML::Mark const&) override {}
+    void OnDocumentEnd() override {}
+
+    void OnNull(YAML::Mark const& _mark, YAML::anchor_t _anchor) override
     {
-        if (_node.Tag() == "tag:yaml.org,2002:int")
-            return DataObject(_node.as<int>());
+        if (skipValue())
+        {
+            if (_anchor)
+                m_anchors[_anchor] = DataObject(DataType::Null);
+            return;
+        }
+        requireValue(_mark);
+        addValue(DataObject(DataType::Null), _anchor);
+    }
+
+    void OnAlias(YAML::Mark const& _mark, YAML::anchor_t _anchor) override
+    {
+        if (skipValue())
+            return;
+        auto const anchored = m_anchors.find(_anchor);
+        if (anchored == m_anchors.end())
+            throw DataObjectException() << error(_mark, "unknown alias");
+        if (expectsKey())
+        {
+            if (anchored->second.type() != DataType::String)
+                throw DataObjectException() << error(_mark, "map key must be a scalar");
+            setKey(anchored->second.asString());
+        }
         else
-            return DataObject(_node.as<string>());
+            addValue(anchored->second, 0);
     }
 
-    if (_node.IsMap())
+    void OnScalar(YAML::Mark const&, std::string const& _tag, YAML::anchor_t _anchor,
+        std::string const& _value) override
     {
-        DataObject jObject(DataType::Object);
-        jObject.setAutosort(true);
-        for (auto const& i : _node)
-            jObject.addSubObject(i.first.as<string>(), ConvertYamlToData(i.second));
-        return jObject;
+        if (skipValue())
+        {
+            if (_anchor)
+                m_anchors[_anchor] = scalarValue(_tag, _value);
+            return;
+        }
+        if (expectsKey())
+        {
+            if (_anchor)
+                m_anchors[_anchor] = DataObject(_value);
+            setKey(_value);
+        }
+        else
+            addValue(scalarValue(_tag, _value), _anchor);
     }
 
-    if (_node.IsSequence())
+    void OnSequenceStart(YAML::Mark const& _mark, std::string const&, YAML::anchor_t _anchor,
+        YAML::EmitterStyle::value) override
     {
-        DataObject jArray(DataType::Array);
-        jArray.setAutosort(true);
-        for (size_t i = 0; i < _node.size(); i++)
-            jArray.addArrayObject(ConvertYamlToData(_node[i]));
-        return jArray;
+        startContainer(_mark, DataType::Array, _anchor);
     }
 
-    // Make it an exception!
-    std::cerr << "Error parsing YAML node. Element type not defined! " + yamlTypeAsString(_node.Type());
-    return DataObject(DataType::Null);
+    void OnSequenceEnd() override { endContainer(); }
+
+    void OnMapStart(YAML::Mark const& _mark, std::string const&, YAML::anchor_t _anchor,
+        YAML::EmitterStyle::value) override
+    {
+        startContainer(_mark, DataType::Object, _anchor);
+    }
+
+    void OnMapEnd() override { endContainer(); }
+
+private:
+    struct Frame
+    {
+        Frame(DataType _type, YAML::anchor_t _anchor) : object(_type), anchor(_anchor)
+        {
+            object.setAutosort(true);
+        }
+        DataObject object;
+        YAML::anchor_t anchor;
+        std::string key;  // key of the next member of a map
+        bool expectKey = true;
+        bool skipped = false;  // a filtered value, nothing is added to object
+        bool anchoredOnly = false;  // a filtered value read only for its anchor
+    };
+
+    static DataObject scalarValue(std::string const& _tag, std::string const& _value)
+    {
+        if (_tag == "tag:yaml.org,2002:int")
+            return DataObject(YAML::Node(_value).as<int>());
+        return DataObject(_value);
+    }
+
+    bool expectsKey() const
+    {
+        return !m_stack.empty() && m_stack.back().object.type() == DataType::Object &&
+               m_stack.back().expectKey;
+    }
+
+    void requireValue(YAML::Mark const& _mark) const
+    {
+        if (expectsKey())
+            throw DataObjectException() << error(_mark, "map key must be a scalar");
+    }
+
+    // Members of a map at depth = number of the containers above it
+    void setKey(std::string const& _key)
+    {
+        if (m_skip.skips(_key, m_stack.size() - 1))
+            m_skipNext = true;
+        else
+        {
+            m_stack.back().key = _key;
+            m_stack.back().expectKey = false;
+        }
+    }
+
+    // Events of a filtered member value are consumed here
+    bool skipValue()
+    {
+        if (!m_stack.empty() && m_stack.back().skipped)
+            return true;
+        if (!m_skipNext)
+            return false;
+        m_skipNext = false;
+        return true;
+    }
+
+    // A filtered value is not built, except for the values with an anchor in it,
+    // an alias outside of the filtered value can refer to them
+    void startContainer(YAML::Mark const& _mark, DataType _type, YAML::anchor_t _anchor)
+    {
+        bool const skipped = skipValue();
+        if (!skipped)
+            requireValue(_mark);
+        m_stack.push_back(Frame(_type, _anchor));
+        m_stack.back().skipped = skipped && !_anchor;
+        m_stack.back().anchoredOnly = skipped && _anchor;
+    }
+
+    void endContainer()
+    {
+        Frame frame = std::move(m_stack.back());
+        m_stack.pop_back();
+        if (frame.skipped)
+            return;
+        if (frame.anchoredOnly)
+            m_anchors[frame.anchor] = frame.object;
+        else
+            addValue(frame.object, frame.anchor);
+    }
+
+    void addValue(DataObject const& _value, YAML::anchor_t _anchor)
+    {
+        if (_anchor)
+            m_anchors[_anchor] = _value;
+        if (m_stack.empty())
+        {
+            m_result = _value;
+            return;
+        }
+        Frame& parent = m_stack.back();
+        if (parent.object.type() == DataType::Object)
+        {
+            parent.object.addSubObject(parent.key, _value);
+            parent.expectKey = true;
+        }
+        else
+            parent.object.addArrayObject(_value);
+    }
+
+    static std::string error(YAML::Mark const& _mark, std::string const& _message)
+    {
+        return "Error parsing yaml: " + _message + " at line " + std::to_string(_mark.line + 1) +
+               ", column " + std::to_string(_mark.column + 1);
+    }
+
+    KeyFilter const& m_skip;
+    std::vector<Frame> m_stack;
+    std::map<YAML::anchor_t, DataObject> m_anchors;
+    DataObject m_result;
+    bool m_skipNext = false;  // next value belongs to a filtered member
+};
+}  // namespace
+
+DataObject ConvertYamlToData(dev::ReadOnlyView const& _input, KeyFilter const& _skip)
+{
+    ViewStreamBuf buffer(_input);
+    std::istream stream(&buffer);
+    YAML::Parser parser(stream);
+    YamlDataBuilder builder(_skip);
+    parser.HandleNextDocument(builder);
+    return builder.result();
 }
 
 }//namespace
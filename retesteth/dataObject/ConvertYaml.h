@@ -1,11 +1,14 @@
 #pragma once
 #include <dataObject/DataObject.h>
+#include <dataObject/KeyFilter.h>
 #include <yaml-cpp/yaml.h>
 
 namespace dataobject
 {
 std::string yamlTypeAsString(YAML::NodeType::value _type);
 
-/// Convert Yaml object to DataObject
-DataObject ConvertYamlToData(YAML::Node const& _input);
+/// Convert yaml text to DataObject in one pass over the yaml parser events
+/// No YAML::Node graph of the document is made on the way
+/// Map members filtered by _skip are not converted, anchors defined inside them are still read
+DataObject ConvertYamlToData(dev::ReadOnlyView const& _input, KeyFilter const& _skip = KeyFilter());
 }
@@ -1,6 +1,28 @@
 #include <dataObject/DataObject.h>
+#include <dataObject/JsonOutput.h>
+#include <dataObject/KeyFilter.h>
 using namespace dataobject;
 
+namespace
+{
+// FNV-1a
+size_t hashBytes(char const* _data, size_t _size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < _size; i++)
+    {
+        hash ^= static_cast<unsigned char>(_data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+size_t hashCombine(size_t _seed, size_t _value)
+{
+    return _seed ^ (_value + 0x9e3779b9 + (_seed << 6) + (_seed >> 2));
+}
+}  // namespace
+
 /// Default dataobject is null
 DataObject::DataObject()
 {
@@ -56,27 +78,40 @@ DataType DataObject::type() const
 }
 
 /// Set key of the dataobject
-void DataObject::setKey(std::string const& _key)
+void DataObject::setKey(std::string _key)
 {
-    m_strKey = _key;
+    m_strKey = std::move(_key);
 }
 
 /// Get key of the dataobject
 std::string const& DataObject::getKey() const
 {
-    return m_strKey;
+    return m_strKey.str();
 }
 
 /// Get vector of subobjects
 std::vector<DataObject> const& DataObject::getSubObjects() const
 {
-    return m_subObjects;
+    static std::vector<DataObject> const empty;
+    return m_subObjects ? *m_subObjects : empty;
 }
 
 /// Get ref vector of subobjects
 std::vector<DataObject>& DataObject::getSubObjectsUnsafe()
 {
-    return m_subObjects;
+    return detachSubObjects();
+}
+
+/// Make own copy of the subobjects vector if it is shared with other copies of this object
+/// Subobjects of the copy still share their subtrees
+std::vector<DataObject>& DataObject::detachSubObjects()
+{
+    m_hashValid = false;
+    if (!m_subObjects)
+        m_subObjects = std::make_shared<std::vector<DataObject>>();
+    else if (m_subObjects.use_count() > 1)
+        m_subObjects = std::make_shared<std::vector<DataObject>>(*m_subObjects);
+    return *m_subObjects;
 }
 
 /// Add new subobject
@@ -94,16 +129,17 @@ DataObject& DataObject::addSubObject(std::string const& _key, DataObject const&
 /// Set key for subobject _index
 void DataObject::setSubObjectKey(size_t _index, std::string const& _key)
 {
-    _assert(_index < m_subObjects.size(), "_index < m_subObjects.size() (DataObject::setSubObjectKey)");
-    if (m_subObjects.size() > _index)
-        m_subObjects.at(_index).setKey(_key);
+    std::vector<DataObject>& subObjects = detachSubObjects();
+    _assert(_index < subObjects.size(), "_index < m_subObjects.size() (DataObject::setSubObjectKey)");
+    if (subObjects.size() > _index)
+        subObjects.at(_index).setKey(_key);
 }
 
 /// look if there is a subobject with _key
 bool DataObject::count(std::string const& _key) const
 {
-    for (auto const& i : m_subObjects)
-        if (i.getKey() == _key)
+    for (auto const& i : getSubObjects())
+        if (i.m_strKey == _key)
             return true;
     return false;
 }
@@ -112,6 +148,63 @@ bool DataObject::count(std::string const& _key) const
 std::string const& DataObject::asString() const
 {
     _assert(m_type == DataType::String, "m_type == DataType::String (DataObject::asString())");
+    return strVal().str();
+}
+
+/// Get string value as number
+dev::u256 const& DataObject::asU256() const
+{
+    _assert(m_type == DataType::String, "m_type == DataType::String (DataObject::asU256())");
+    if (!m_numVal)
+        m_numVal = std::make_shared<dev::u256>(strVal().str());
+    return *m_numVal;
+}
+
+/// Get string value as byte string
+dev::bytes const& DataObject::asBytes() const
+{
+    _assert(m_type == DataType::String, "m_type == DataType::String (DataObject::asBytes())");
+    if (!m_bytesVal)
+        m_bytesVal =
+            std::make_shared<dev::bytes>(dev::fromHex(strVal().str(), dev::WhenError::Throw));
+    return *m_bytesVal;
+}
+
+void DataObject::setU256(dev::u256 const& _value)
+{
+    _assert(m_type == DataType::String || m_type == DataType::Null,
+        "In DataObject::setU256 DataObject must be string or Null!");
+    m_type = DataType::String;
+    m_numVal = std::make_shared<dev::u256>(_value);
+    m_bytesVal.reset();
+    m_strVal = std::string();
+    m_strPending = true;
+    m_hashValid = false;
+}
+
+void DataObject::setBytes(dev::bytes const& _value)
+{
+    _assert(m_type == DataType::String || m_type == DataType::Null,
+        "In DataObject::setBytes DataObject must be string or Null!");
+    m_type = DataType::String;
+    m_numVal.reset();
+    m_bytesVal = std::make_shared<dev::bytes>(_value);
+    m_strVal = std::string();
+    m_strPending = true;
+    m_hashValid = false;
+}
+
+/// Get string value, make it from the native value if it was set with setU256 or setBytes
+DataString const& DataObject::strVal() const
+{
+    if (m_strPending)
+    {
+        if (m_numVal)
+            m_strVal = dev::toCompactHexPrefixed(*m_numVal, 1);
+        else
+            m_strVal = dev::toHexPrefixed(*m_bytesVal);
+        m_strPending = false;
+    }
     return m_strVal;
 }
 
@@ -132,13 +225,14 @@ bool DataObject::asBool() const
 /// Set position in vector of the subobject with _key
 void DataObject::setKeyPos(std::string const& _key, size_t _pos)
 {
-    _assert(_pos < m_subObjects.size(), "_pos < m_subObjects.size()");
+    std::vector<DataObject> const& subObjects = getSubObjects();
+    _assert(_pos < subObjects.size(), "_pos < m_subObjects.size()");
     _assert(count(_key), "count(_key) _key = " + _key + " (DataObject::setKeyPos)");
     _assert(!_key.empty(), "!_key.empty() (DataObject::setKeyPos)");
 
     size_t elementPos = 0;
-    for (size_t i = 0; i < m_subObjects.size(); i++)
-        if (m_subObjects.at(i).getKey() == _key)
+    for (size_t i = 0; i < subObjects.size(); i++)
+        if (subObjects.at(i).m_strKey == _key)
         {
             if (i == _pos)
                 return;  // item already at _pos;
@@ -150,9 +244,10 @@ void DataObject::setKeyPos(std::string const& _key, size_t _pos)
         }
 
     setOverwrite(true);
-    DataObject data = m_subObjects.at(elementPos);
-    m_subObjects.erase(m_subObjects.begin() + elementPos);
-    m_subObjects.insert(m_subObjects.begin() + _pos, 1, data);
+    std::vector<DataObject>& objects = detachSubObjects();
+    DataObject data = objects.at(elementPos);
+    objects.erase(objects.begin() + elementPos);
+    objects.insert(objects.begin() + _pos, 1, data);
     setOverwrite(false);
 }
 
@@ -160,11 +255,14 @@ void DataObject::setKeyPos(std::string const& _key, size_t _pos)
 /// replace this object with _value
 void DataObject::replace(DataObject const& _value)
 {
-    m_strKey = _value.getKey();
+    m_strKey = _value.m_strKey;
     switch (_value.type())
     {
     case DataType::String:
-        m_strVal = _value.asString();
+        m_strVal = _value.m_strVal;
+        m_numVal = _value.m_numVal;
+        m_bytesVal = _value.m_bytesVal;
+        m_strPending = _value.m_strPending;
         break;
     case DataType::Integer:
         m_intVal = _value.asInt();
@@ -177,26 +275,27 @@ void DataObject::replace(DataObject const& _value)
     }
 
     m_type = _value.type();
-    m_subObjects.clear();
-    m_subObjects = _value.getSubObjects();
     m_allowOverwrite = _value.isOverwritable();
     setAutosort(_value.isAutosort());
+    m_hash = _value.m_hash;
+    m_hashValid = _value.m_hashValid;
+    m_subObjects = _value.m_subObjects;  // last, _value could be one of the subobjects
 }
 
 DataObject const& DataObject::atKey(std::string const& _key) const
 {
     _assert(count(_key), "count(_key) _key=" + _key + " (DataObject::at)");
-    for (auto const& i : m_subObjects)
-        if (i.getKey() == _key)
+    for (auto const& i : getSubObjects())
+        if (i.m_strKey == _key)
             return i;
     _assert(false, "item not found! (DataObject::at)");
-    return m_subObjects.at(0);
+    return getSubObjects().at(0);
 }
 
 DataObject const& DataObject::at(size_t _pos) const
 {
-    _assert((size_t)_pos < m_subObjects.size(), "DataObject::at(int) out of range!");
-    return m_subObjects[_pos];
+    _assert((size_t)_pos < getSubObjects().size(), "DataObject::at(int) out of range!");
+    return getSubObjects()[_pos];
 }
 
 void DataObject::addArrayObject(DataObject const& _obj)
@@ -204,17 +303,18 @@ void DataObject::addArrayObject(DataObject const& _obj)
     _assert(m_type == DataType::Null || m_type == DataType::Array,
         "m_type == DataType::Null || m_type == DataType::Array (DataObject::addArrayObject)");
     m_type = DataType::Array;
-    m_subObjects.push_back(_obj);
-    m_subObjects.at(m_subObjects.size() - 1).setAutosort(m_autosort);
+    std::vector<DataObject>& subObjects = detachSubObjects();
+    subObjects.push_back(_obj);
+    subObjects.at(subObjects.size() - 1).setAutosort(m_autosort);
 }
 
 void DataObject::renameKey(std::string const& _currentKey, std::string const& _newKey)
 {
     if (m_strKey == _currentKey)
         m_strKey = _newKey;
-    for (auto& obj : m_subObjects)
+    for (auto& obj : detachSubObjects())
     {
-        if (!obj.getKey().empty() && obj.getKey() == _currentKey)
+        if (!obj.m_strKey.empty() && obj.m_strKey == _currentKey)
         {
             obj.setKey(_newKey);
             break;
@@ -226,36 +326,51 @@ void DataObject::renameKey(std::string const& _currentKey, std::string const& _n
 void DataObject::removeKey(std::string const& _key)
 {
     _assert(type() == DataType::Object, "type() == DataType::Object");
-    for (std::vector<DataObject>::const_iterator it = m_subObjects.begin();
-         it != m_subObjects.end(); it++)
+    std::vector<DataObject>& subObjects = detachSubObjects();
+    for (std::vector<DataObject>::const_iterator it = subObjects.begin(); it != subObjects.end();
+         it++)
     {
-        if ((*it).getKey() == _key)
+        if ((*it).m_strKey == _key)
         {
             setOverwrite(true);
-            m_subObjects.erase(it);
+            subObjects.erase(it);
             setOverwrite(false);
+            break;  // it is invalidated by erase
         }
     }
+}
 
-    /*
-    bool startReplace = false;
-    for (std::vector<DataObject>::iterator it = m_subObjects.begin(); it != m_subObjects.end();
-         it++)
+void DataObject::removeFilteredKeys(KeyFilter const& _filter, size_t _depth)
+{
+    if (m_type != DataType::Object && m_type != DataType::Array)
+        return;
+    std::vector<DataObject>& subObjects = detachSubObjects();
+    if (m_type == DataType::Object)
     {
-        if ((*it).getKey() == _key)
-            startReplace = true;
-        std::vector<DataObject>::iterator next = it + 1;
-        if (startReplace)
+        // kept members are moved into a new vector, erase would shift them on every removal
+        std::vector<DataObject> kept;
+        bool removed = false;
+        for (size_t i = 0; i < subObjects.size(); i++)
         {
-            if (next != m_subObjects.end())
-                (*it).replace(*next);
-            else
+            DataString const& key = subObjects.at(i).m_strKey;
+            if (_filter.skips(key.data(), key.size(), _depth))
             {
-                m_subObjects.erase(it);
-                break;
+                if (!removed)
+                {
+                    kept.reserve(subObjects.size() - 1);
+                    for (size_t j = 0; j < i; j++)
+                        kept.push_back(std::move(subObjects.at(j)));
+                }
+                removed = true;
             }
+            else if (removed)
+                kept.push_back(std::move(subObjects.at(i)));
         }
-    }*/
+        if (removed)
+            subObjects.swap(kept);
+    }
+    for (auto& subObject : subObjects)
+        subObject.removeFilteredKeys(_filter, _depth + 1);
 }
 
 void DataObject::clear(DataType _type)
@@ -263,141 +378,162 @@ void DataObject::clear(DataType _type)
     m_intVal = 0;
     m_strKey = "";
     m_strVal = "";
-    m_subObjects.clear();
+    m_numVal.reset();
+    m_bytesVal.reset();
+    m_strPending = false;
+    m_hashValid = false;
+    m_subObjects.reset();
     m_type = _type;
 }
 
 std::string DataObject::asJson(int level, bool pretty) const
 {
-    std::ostringstream out;
-    auto printLevel = [level, pretty, &out]() -> void {
+    std::string out;
+    {
+        StringJsonOutput output(out);
+        streamJson(output, level, pretty);
+    }
+    return out;
+}
+
+/// Write json representation into _out in a single pass without intermediate strings
+void DataObject::streamJson(JsonOutput& _out, int level, bool pretty) const
+{
+    auto printLevel = [level, pretty, &_out]() -> void {
+        if (pretty)
+            _out.writeIndent(level * 4);
+    };
+
+    auto printKey = [this, pretty, &_out]() -> void {
+        if (m_strKey.empty())
+            return;
+        _out.write('"');
+        _out.write(m_strKey.data(), m_strKey.size());
         if (pretty)
-            for (int i = 0; i < level * 4; i++)
-                out << " ";
+            _out.write("\" : ", 4);
+        else
+            _out.write("\":", 2);
     };
 
-    auto printElements = [this, &out, level, pretty]() -> void {
-        for (std::vector<DataObject>::const_iterator it = this->m_subObjects.begin();
-             it < this->m_subObjects.end(); it++)
+    auto printElements = [this, &_out, level, pretty]() -> void {
+        std::vector<DataObject> const& subObjects = this->getSubObjects();
+        for (std::vector<DataObject>::const_iterator it = subObjects.begin();
+             it < subObjects.end(); it++)
         {
-            out << (*it).asJson(level + 1, pretty);
-            if (it + 1 != this->m_subObjects.end())
-                out << ",";
+            (*it).streamJson(_out, level + 1, pretty);
+            if (it + 1 != subObjects.end())
+                _out.write(',');
             if (pretty)
-                out << std::endl;
+                _out.write('\n');
         }
     };
 
-    string buffer;
+    auto printContainer = [this, &_out, pretty, &printLevel, &printKey, &printElements](
+                              char _open, char _close) -> void {
+        printLevel();
+        printKey();
+        _out.write(_open);
+        if (pretty)
+            _out.write('\n');
+        printElements();
+        printLevel();
+        _out.write(_close);
+    };
+
     switch (m_type)
     {
     case DataType::Null:
         printLevel();
-        if (!m_strKey.empty())
-        {
-            if (pretty)
-                out << "\"" << m_strKey << "\" : ";
-            else
-                out << "\"" << m_strKey << "\":";
-        }
-        //out << "\"" << "null" << "\"";
-        out << "{}";
+        printKey();
+        _out.write("{}", 2);
         break;
     case DataType::Object:
-        if (!m_strKey.empty())
-        {
-            printLevel();
-            if (pretty)
-                out << "\"" << m_strKey << "\" : {" << std::endl;
-            else
-                out << "\"" << m_strKey << "\":{";
-        }
-        else
-        {
-            printLevel();
-            out << "{";
-            if (pretty)
-                out << std::endl;
-        }
-        printElements();
-        printLevel();
-        out << "}";
+        printContainer('{', '}');
         break;
     case DataType::Array:
-        if (!m_strKey.empty())
-        {
-            printLevel();
-            if (pretty)
-                out << "\"" << m_strKey << "\" : [" << std::endl;
-            else
-                out << "\"" << m_strKey << "\":[";
-        }
-        else
-        {
-            printLevel();
-            out << "[";
-            if (pretty)
-                out << std::endl;
-        }
-        printElements();
-        printLevel();
-        out << "]";
+        printContainer('[', ']');
         break;
     case DataType::String:
+    {
         printLevel();
-        if (pretty)
-        {
-            if (!m_strKey.empty())
-                out << "\"" << m_strKey << "\" : ";
-        }
-        else
-        {
-            if (!m_strKey.empty())
-                out << "\"" << m_strKey << "\":";
-        }
-
+        printKey();
+        _out.write('"');
         //  threat special chars
-        for (auto const& ch: m_strVal)
+        DataString const& str = strVal();
+        for (char const* it = str.data(); it != str.data() + str.size(); it++)
         {
+            char const ch = *it;
             if (ch == 10)
-                buffer += "\\n";
+                _out.write("\\n", 2);
             else if (ch == 9)
-                buffer += "\\t";
+                _out.write("\\t", 2);
             else
-                buffer += ch;
+                _out.write(ch);
         }
-        out << "\"" << buffer << "\"";
+        _out.write('"');
         break;
+    }
     case DataType::Integer:
         printLevel();
-        if (!m_strKey.empty())
-        {
-            if (pretty)
-                out << "\"" << m_strKey << "\" : ";
-            else
-                out << "\"" << m_strKey << "\":";
-        }
-        out << m_intVal;
+        printKey();
+        _out.writeInt(m_intVal);
         break;
     case DataType::Bool:
         printLevel();
-        if (!m_strKey.empty())
-        {
-            if (pretty)
-                out << "\"" << m_strKey << "\" : ";
-            else
-                out << "\"" << m_strKey << "\":";
-        }
+        printKey();
         if (m_boolVal)
-            out << "true";
+            _out.write("true", 4);
         else
-            out << "false";
+            _out.write("false", 5);
+        break;
+    default:
+        _out.write("unknown " + dataTypeAsString(m_type) + "\n");
+        break;
+    }
+}
+
+void DataObject::convertPendingStrings() const
+{
+    if (m_type == DataType::String)
+        strVal();
+    for (auto const& obj : getSubObjects())
+        obj.convertPendingStrings();
+}
+
+size_t DataObject::structuralHash() const
+{
+    if (m_hashValid)
+        return m_hash;
+
+    size_t hash = hashCombine(0, m_type);
+    switch (m_type)
+    {
+    case DataType::String:
+    {
+        DataString const& str = strVal();
+        hash = hashCombine(hash, hashBytes(str.data(), str.size()));
+        break;
+    }
+    case DataType::Integer:
+        hash = hashCombine(hash, static_cast<size_t>(m_intVal));
+        break;
+    case DataType::Bool:
+        hash = hashCombine(hash, m_boolVal ? 1 : 0);
+        break;
+    case DataType::Array:
+    case DataType::Object:
+        for (auto const& obj : getSubObjects())
+        {
+            hash = hashCombine(hash, hashBytes(obj.m_strKey.data(), obj.m_strKey.size()));
+            hash = hashCombine(hash, obj.structuralHash());
+        }
         break;
     default:
-        out << "unknown " << dataTypeAsString(m_type) << std::endl;
         break;
     }
-    return out.str();
+    m_hash = hash;
+    m_hashValid = true;
+    return m_hash;
 }
 
 std::string DataObject::dataTypeAsString(DataType _type)
@@ -451,33 +587,34 @@ DataObject& DataObject::_addSubObject(DataObject const& _obj, string const& _key
 
     size_t pos;
     string const& key = _keyOverwrite.empty() ? _obj.getKey() : _keyOverwrite;
+    std::vector<DataObject>& subObjects = detachSubObjects();
 
     if (key.empty() || !m_autosort)
     {
-        m_subObjects.push_back(_obj);
-        pos = m_subObjects.size() - 1;
+        subObjects.push_back(_obj);
+        pos = subObjects.size() - 1;
         setSubObjectKey(pos, key);
-        m_subObjects.at(pos).setOverwrite(m_allowOverwrite);
-        m_subObjects.at(pos).setAutosort(m_autosort);
+        subObjects.at(pos).setOverwrite(m_allowOverwrite);
+        subObjects.at(pos).setAutosort(m_autosort);
     }
     else
     {
         // find ordered position to insert key
         // better use it only when export as ordered json !!!
-        pos = findOrderedKeyPosition(key, m_subObjects);
-        if (pos == m_subObjects.size())
-            m_subObjects.push_back(_obj);
+        pos = findOrderedKeyPosition(key, subObjects);
+        if (pos == subObjects.size())
+            subObjects.push_back(_obj);
         else
         {
             setOverwrite(true);
-            m_subObjects.insert(m_subObjects.begin() + pos, 1, _obj);
+            subObjects.insert(subObjects.begin() + pos, 1, _obj);
             setOverwrite(false);
         }
-        m_subObjects.at(pos).setKey(key);
-        m_subObjects.at(pos).setOverwrite(true);
-        m_subObjects.at(pos).setAutosort(m_autosort);
+        subObjects.at(pos).setKey(key);
+        subObjects.at(pos).setOverwrite(true);
+        subObjects.at(pos).setAutosort(m_autosort);
     }
-    return m_subObjects.at(pos);
+    return subObjects.at(pos);
 }
 
 void DataObject::_assert(bool _flag, std::string const& _comment) const
@@ -486,7 +623,7 @@ void DataObject::_assert(bool _flag, std::string const& _comment) const
     {
         // Make it an exception!
         std::cerr << "Error in DataObject: " << std::endl;
-        std::cerr << " key: '" << m_strKey << "'";
+        std::cerr << " key: '" << m_strKey.str() << "'";
         std::cerr << " type: '" << dataTypeAsString(m_type) << "'" << std::endl;
         std::cerr << " assert: " << _comment << std::endl;
         assert(_flag);
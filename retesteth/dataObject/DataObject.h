@@ -1,11 +1,15 @@
 #pragma once
+#include <dataObject/DataString.h>
 #include <dataObject/Exception.h>
 #include <libdevcore/CommonIO.h>
+#include <libdevcore/FixedHash.h>
 #include <memory>
 #include <vector>
 
 namespace dataobject
 {
+class JsonOutput;
+class KeyFilter;
 enum DataType
 {
     String,
@@ -28,8 +32,14 @@ public:
     DataObject(std::string const& _key, std::string const& _str);
     DataObject(std::string const& _key, int _val);
     DataObject(int _int);
+    DataObject(DataObject const&) = default;
+    DataObject(DataObject&&) = default;  // vector<DataObject> reallocation moves the subtrees
     DataType type() const;
-    void setKey(std::string const& _key);
+    void setKey(std::string _key);
+    void setKeyView(dev::ReadOnlyView const& _source, size_t _pos, size_t _size)
+    {
+        m_strKey.setView(_source, _pos, _size);
+    }
     std::string const& getKey() const;
     std::vector<DataObject> const& getSubObjects() const;
     std::vector<DataObject>& getSubObjectsUnsafe();
@@ -42,13 +52,20 @@ public:
     int asInt() const;
     bool asBool() const;
 
+    /// Value of the hex string parsed on first request and kept till the string is changed
+    /// Same as dev::u256(asString()), dev::h256(asString()), dev::fromHex(asString())
+    dev::u256 const& asU256() const;
+    dev::bytes const& asBytes() const;
+    dev::h256 asH256() const { return dev::h256(asBytes()); }
+    dev::h160 asH160() const { return dev::h160(asBytes()); }
+
     void setKeyPos(std::string const& _key, size_t _pos);
     DataObject& operator[](std::string const& _key)
     {
         _assert(m_type == DataType::Null || m_type == DataType::Object,
             "m_type == DataType::Null || m_type == DataType::Object (DataObject& operator[])");
-        for (auto& i : m_subObjects)
-            if (i.getKey() == _key)
+        for (auto& i : detachSubObjects())
+            if (i.m_strKey == _key)
                 return i;
         DataObject newObj(DataType::Null);
         newObj.setKey(_key);
@@ -61,14 +78,23 @@ public:
         return *this;
     }
 
-    void setString(string const& _value)
+    void setString(std::string _value)
     {
         _assert(m_type == DataType::String || m_type == DataType::Null,
             "In DataObject=(string) DataObject must be string or Null!");
         m_type = DataType::String;
-        m_strVal = _value;
+        m_strVal = std::move(_value);
+        m_numVal.reset();
+        m_bytesVal.reset();
+        m_strPending = false;
+        m_hashValid = false;
     }
 
+    /// Set string value from the number, the hex text is made when it is requested
+    void setU256(dev::u256 const& _value);
+    /// Set string value from the byte string, the hex text is made when it is requested
+    void setBytes(dev::bytes const& _value);
+
     DataObject& operator=(int _value)
     {
         setInt(_value);
@@ -81,6 +107,20 @@ public:
             "In DataObject=(int) DataObject must be int or Null!");
         m_type = DataType::Integer;
         m_intVal = _value;
+        m_hashValid = false;
+    }
+
+    /// Set string value referring to the range of _source without copying it
+    void setStringView(dev::ReadOnlyView const& _source, size_t _pos, size_t _size)
+    {
+        _assert(m_type == DataType::String || m_type == DataType::Null,
+            "In DataObject::setStringView DataObject must be string or Null!");
+        m_type = DataType::String;
+        m_strVal.setView(_source, _pos, _size);
+        m_numVal.reset();
+        m_bytesVal.reset();
+        m_strPending = false;
+        m_hashValid = false;
     }
 
     void setBool(bool _value)
@@ -89,6 +129,7 @@ public:
             "In DataObject:setBool(bool) DataObject must be bool or Null!");
         m_type = DataType::Bool;
         m_boolVal = _value;
+        m_hashValid = false;
     }
 
     bool operator==(bool _value) const
@@ -97,13 +138,12 @@ public:
         return *this == tmp;
     }
 
+    /// Compare the values and subobjects with their keys, own keys are not compared
     bool operator==(DataObject const& _value) const
     {
         if (type() != _value.type() || getSubObjects().size() != _value.getSubObjects().size())
             return false;
         bool equal = true;
-        equal = m_type == _value.type();
-        equal = getKey() == _value.getKey();
         switch (m_type)
         {
         case DataType::Bool:
@@ -113,25 +153,19 @@ public:
             equal = asInt() == _value.asInt();
             break;
         case DataType::String:
-            equal = asString() == _value.asString();
+            equal = strVal() == _value.strVal();
             break;
         case DataType::Array:
-            equal = getSubObjects().size() == _value.getSubObjects().size();
+        case DataType::Object:
             for (size_t i = 0; i < getSubObjects().size(); i++)
             {
-                equal = getSubObjects().at(i) == _value.getSubObjects().at(i);
+                DataObject const& obj = getSubObjects().at(i);
+                DataObject const& valueObj = _value.getSubObjects().at(i);
+                equal = obj.m_strKey == valueObj.m_strKey && obj == valueObj;
                 if (!equal)
                     break;
             }
             break;
-        case DataType::Object:
-            _assert(getSubObjects().size() == 1,
-                "in DataObject::==(Object)  Type Object must have only 1 object!");
-            _assert(_value.getSubObjects().size() == 1,
-                "in DataObject::==(Object)  Type Object must have only 1 object!");
-            equal = getSubObjects().size() == _value.getSubObjects().size();
-            equal = getSubObjects().at(0) == _value.getSubObjects().at(0);
-            break;
         default:
             _assert(false, "in DataObject::== unknown object type!");
             equal = false;
@@ -166,7 +200,10 @@ public:
             m_intVal = _value.asInt();
             break;
         case DataType::String:
-            m_strVal = _value.asString();
+            m_strVal = _value.m_strVal;
+            m_numVal = _value.m_numVal;
+            m_bytesVal = _value.m_bytesVal;
+            m_strPending = _value.m_strPending;
             break;
         case DataType::Bool:
             m_boolVal = _value.asBool();
@@ -176,7 +213,9 @@ public:
         }
         m_allowOverwrite = _value.isOverwritable();
         setAutosort(_value.isAutosort());
-        m_subObjects = _value.getSubObjects();
+        m_hash = _value.m_hash;
+        m_hashValid = _value.m_hashValid;
+        m_subObjects = _value.m_subObjects;
         return *this;
     }
 
@@ -192,11 +231,26 @@ public:
     /// vector<element> erase method with `replace()` function
     void removeKey(std::string const& _key);
 
+    /// Remove the members filtered by _filter at any level in one pass over the tree
+    /// _depth is the depth of this object, 0 for the top level object
+    void removeFilteredKeys(KeyFilter const& _filter, size_t _depth = 0);
+
     void clear(DataType _type = DataType::Null);
 
     std::string asJson(int level = 0, bool pretty = true) const;
+    void streamJson(JsonOutput& _out, int level = 0, bool pretty = true) const;
     static std::string dataTypeAsString(DataType _type);
 
+    /// Hash of the type, the value and the subobjects with their keys, own key is not included
+    /// Kept until the object is modified. Modification of a subobject goes through the non const
+    /// accessors of its parents which drop their hashes on the way, but a subobject modified
+    /// through a reference taken before the hash was made leaves the hashes of its parents stale
+    size_t structuralHash() const;
+
+    /// Make the string values set with setU256 or setBytes in the whole tree,
+    /// so that the object can be read from several threads
+    void convertPendingStrings() const;
+
     void setOverwrite(bool _overwrite) { m_allowOverwrite = _overwrite; }
     void setAutosort(bool _sort)
     {
@@ -207,18 +261,30 @@ public:
     bool isAutosort() const { return m_autosort; }
     void clearSubobjects()
     {
-        m_subObjects.clear();
+        m_subObjects.reset();
         m_type = DataType::Null;
+        m_hashValid = false;
     }
 
 private:
     DataObject& _addSubObject(DataObject const& _obj, string const& _keyOverwrite = string());
     void _assert(bool _flag, std::string const& _comment = "") const;
+    std::vector<DataObject>& detachSubObjects();
+    DataString const& strVal() const;
 
-    std::vector<DataObject> m_subObjects;
+    /// Subobjects are shared between the copies of DataObject until one of them is modified
+    /// Null pointer is an empty vector. A reference got from a non const accessor
+    /// must not be used to modify the object once the object is copied
+    std::shared_ptr<std::vector<DataObject>> m_subObjects;
     DataType m_type;
-    std::string m_strKey;
-    std::string m_strVal;
+    DataString m_strKey;
+    mutable DataString m_strVal;
+    /// Parsed values of m_strVal, immutable and shared between the copies
+    mutable std::shared_ptr<dev::u256 const> m_numVal;
+    mutable std::shared_ptr<dev::bytes const> m_bytesVal;
+    mutable bool m_strPending = false;  // m_strVal is not yet made from the parsed value
+    mutable size_t m_hash = 0;
+    mutable bool m_hashValid = false;
     bool m_allowOverwrite = false;  // allow overwrite elements
     bool m_autosort = false;
     bool m_boolVal;
@@ -0,0 +1,69 @@
+#pragma once
+#include <libdevcore/CommonIO.h>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace dataobject
+{
+/// String of the DataObject key or value
+/// Either owns its chars or refers to a range of a shared source (json parsed in view mode)
+/// Copying a view copies only the reference to the source
+/// A view is copied into own std::string the first time it is requested as std::string,
+/// so view backed objects must not be read from several threads before that
+class DataString
+{
+public:
+    DataString() {}
+    DataString(std::string const& _str) : m_str(_str) {}
+    DataString& operator=(std::string const& _str)
+    {
+        m_owner.reset();
+        m_str = _str;
+        return *this;
+    }
+    DataString& operator=(std::string&& _str)
+    {
+        m_owner.reset();
+        m_str = std::move(_str);
+        return *this;
+    }
+
+    /// Refer to _size chars of _source at _pos instead of owning a copy
+    void setView(dev::ReadOnlyView const& _source, size_t _pos, size_t _size)
+    {
+        m_str.clear();
+        m_owner = _source.owner();
+        m_data = _source.data() + _pos;
+        m_size = _size;
+    }
+
+    std::string const& str() const
+    {
+        if (m_owner)
+        {
+            m_str.assign(m_data, m_size);
+            m_owner.reset();
+        }
+        return m_str;
+    }
+
+    char const* data() const { return m_owner ? m_data : m_str.data(); }
+    size_t size() const { return m_owner ? m_size : m_str.size(); }
+    bool empty() const { return size() == 0; }
+
+    bool equals(char const* _data, size_t _size) const
+    {
+        return size() == _size && std::memcmp(data(), _data, _size) == 0;
+    }
+    bool operator==(std::string const& _str) const { return equals(_str.data(), _str.size()); }
+    bool operator==(DataString const& _str) const { return equals(_str.data(), _str.size()); }
+    bool operator!=(std::string const& _str) const { return !equals(_str.data(), _str.size()); }
+
+private:
+    mutable std::string m_str;
+    mutable std::shared_ptr<void const> m_owner;  // set while the string is a view
+    char const* m_data = nullptr;
+    size_t m_size = 0;
+};
+}
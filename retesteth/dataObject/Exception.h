@@ -1,5 +1,4 @@
 #pragma once
-#include <dataObject/DataObject.h>
 #include <exception>
 #include <string>
 #include <vector>
@@ -0,0 +1,154 @@
+#include <dataObject/DataObject.h>
+#include <dataObject/Exception.h>
+#include <dataObject/JsonOutput.h>
+#include <boost/filesystem/operations.hpp>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <thread>
+
+namespace fs = boost::filesystem;
+using namespace dataobject;
+
+namespace
+{
+// Same output as _data.streamJson(_out, 0, _pretty) with the members serialized on _threads threads
+void streamMembersParallel(JsonOutput& _out, DataObject const& _data, bool _pretty, size_t _threads)
+{
+    // Lazy values of the tree (shared by the copies) are made here and only read by the threads
+    _data.convertPendingStrings();
+
+    std::vector<DataObject> const& members = _data.getSubObjects();
+    std::vector<std::string> buffers(members.size());
+    std::vector<std::exception_ptr> errors(_threads);
+    std::atomic<size_t> next(0);
+    auto serialize = [&](size_t _thread) {
+        try
+        {
+            for (size_t i = next++; i < members.size(); i = next++)
+            {
+                StringJsonOutput out(buffers.at(i));
+                members.at(i).streamJson(out, 1, _pretty);
+            }
+        }
+        catch (...)
+        {
+            errors.at(_thread) = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < _threads; i++)
+        threads.emplace_back(serialize, i);
+    serialize(0);
+    for (auto& th : threads)
+        th.join();
+    for (auto const& error : errors)
+        if (error)
+            std::rethrow_exception(error);
+
+    if (!_data.getKey().empty())
+    {
+        _out.write('"');
+        _out.write(_data.getKey());
+        if (_pretty)
+            _out.write("\" : ", 4);
+        else
+            _out.write("\":", 2);
+    }
+    _out.write(_data.type() == DataType::Array ? '[' : '{');
+    if (_pretty)
+        _out.write('\n');
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        _out.write(buffers.at(i));
+        std::string().swap(buffers.at(i));
+        if (i + 1 != buffers.size())
+            _out.write(',');
+        if (_pretty)
+            _out.write('\n');
+    }
+    _out.write(_data.type() == DataType::Array ? ']' : '}');
+}
+}  // namespace
+
+namespace dataobject
+{
+void JsonOutput::write(char const* _data, size_t _size)
+{
+    while (_size > 0)
+    {
+        if (m_pos == m_buffer.size())
+            flush();
+        size_t const chunk = std::min(_size, m_buffer.size() - m_pos);
+        std::memcpy(&m_buffer[m_pos], _data, chunk);
+        m_pos += chunk;
+        _data += chunk;
+        _size -= chunk;
+    }
+}
+
+void JsonOutput::writeInt(int _value)
+{
+    // same output as std::ostream << int
+    char digits[16];
+    size_t pos = sizeof(digits);
+    unsigned absValue = _value < 0 ? 0u - (unsigned)_value : (unsigned)_value;
+    do
+    {
+        digits[--pos] = '0' + absValue % 10;
+        absValue /= 10;
+    } while (absValue);
+    if (_value < 0)
+        digits[--pos] = '-';
+    write(digits + pos, sizeof(digits) - pos);
+}
+
+void JsonOutput::writeIndent(size_t _spaces)
+{
+    static char const spaces[] = "                                                                ";
+    size_t const c_maxChunk = sizeof(spaces) - 1;
+    while (_spaces > 0)
+    {
+        size_t const chunk = std::min(_spaces, c_maxChunk);
+        write(spaces, chunk);
+        _spaces -= chunk;
+    }
+}
+
+FileJsonOutput::FileJsonOutput(fs::path const& _file)
+  : m_stream(_file, std::ios::trunc | std::ios::binary)
+{}
+
+void FileJsonOutput::consume(char const* _data, size_t _size)
+{
+    m_stream.write(_data, _size);
+}
+
+dev::h256 HashDataObjectJson(DataObject const& _data, bool _pretty)
+{
+    SHA3JsonOutput out;
+    _data.streamJson(out, 0, _pretty);
+    return out.hash();
+}
+
+void WriteDataObjectToFile(
+    fs::path const& _file, DataObject const& _data, bool _pretty, size_t _threads)
+{
+    if (!_file.parent_path().empty() && !fs::exists(_file.parent_path()))
+        fs::create_directories(_file.parent_path());
+
+    FileJsonOutput out(_file);
+    bool const isContainer =
+        _data.type() == DataType::Object || _data.type() == DataType::Array;
+    size_t const threads = isContainer ? std::min(_threads, _data.getSubObjects().size()) : 1;
+    if (threads > 1)
+        streamMembersParallel(out, _data, _pretty, threads);
+    else
+        _data.streamJson(out, 0, _pretty);
+    out.flush();
+    if (!out.good())
+        throw DataObjectException() << "Could not write to file: " + _file.string();
+    boost::system::error_code ec;
+    fs::permissions(_file, fs::owner_read | fs::owner_write, ec);
+}
+}
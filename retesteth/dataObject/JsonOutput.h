@@ -0,0 +1,105 @@
+#pragma once
+#include <libdevcore/SHA3.h>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/path.hpp>
+#include <string>
+#include <vector>
+
+namespace dataobject
+{
+class DataObject;
+
+/// Buffered sink for the streaming json serializer
+/// DataObject writes its json representation into the buffer in a single pass
+/// The buffer is handed over to consume() when it is full or on flush()
+class JsonOutput
+{
+public:
+    JsonOutput(size_t _bufferSize = 65536) : m_buffer(_bufferSize), m_pos(0) {}
+    virtual ~JsonOutput() {}
+
+    void write(char _ch)
+    {
+        if (m_pos == m_buffer.size())
+            flush();
+        m_buffer[m_pos++] = _ch;
+    }
+    void write(char const* _data, size_t _size);
+    void write(std::string const& _str) { write(_str.data(), _str.size()); }
+    void writeInt(int _value);
+    void writeIndent(size_t _spaces);
+
+    /// Pass all buffered data to the sink
+    void flush()
+    {
+        if (m_pos)
+            consume(m_buffer.data(), m_pos);
+        m_pos = 0;
+    }
+
+protected:
+    virtual void consume(char const* _data, size_t _size) = 0;
+
+private:
+    std::vector<char> m_buffer;
+    size_t m_pos;
+};
+
+/// Write json into std::string
+class StringJsonOutput : public JsonOutput
+{
+public:
+    StringJsonOutput(std::string& _out) : JsonOutput(4096), m_out(_out) {}
+    ~StringJsonOutput() { flush(); }
+
+protected:
+    void consume(char const* _data, size_t _size) override { m_out.append(_data, _size); }
+
+private:
+    std::string& m_out;
+};
+
+/// Write json into file. File is truncated on construction
+class FileJsonOutput : public JsonOutput
+{
+public:
+    FileJsonOutput(boost::filesystem::path const& _file);
+    ~FileJsonOutput() { flush(); }
+    bool good() const { return m_stream.good(); }
+
+protected:
+    void consume(char const* _data, size_t _size) override;
+
+private:
+    boost::filesystem::ofstream m_stream;
+};
+
+/// Feed json into SHA3-256 hash. The json string is not built
+class SHA3JsonOutput : public JsonOutput
+{
+public:
+    dev::h256 hash()
+    {
+        flush();
+        return m_sha3.hash();
+    }
+
+protected:
+    void consume(char const* _data, size_t _size) override
+    {
+        m_sha3.append(dev::bytesConstRef(reinterpret_cast<dev::byte const*>(_data), _size));
+    }
+
+private:
+    dev::SHA3Stream m_sha3;
+};
+
+/// SHA3-256 hash of _data.asJson(0, _pretty) computed without building the json string
+dev::h256 HashDataObjectJson(DataObject const& _data, bool _pretty = true);
+
+/// Serialize DataObject into a file without building the json string in memory
+/// With _threads > 1 the members of a top level object or array (tests of a test file)
+/// are serialized in parallel into own buffers which are written in order
+void WriteDataObjectToFile(boost::filesystem::path const& _file, DataObject const& _data,
+    bool _pretty = true, size_t _threads = 1);
+}
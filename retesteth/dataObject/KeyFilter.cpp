@@ -0,0 +1,56 @@
+#include <dataObject/KeyFilter.h>
+#include <cstring>
+
+namespace
+{
+bool matchAny(std::vector<std::string> const& _keys, char const* _key, size_t _size)
+{
+    for (auto const& key : _keys)
+        if (key.size() == _size && std::memcmp(key.data(), _key, _size) == 0)
+            return true;
+    return false;
+}
+}  // namespace
+
+namespace dataobject
+{
+KeyFilter& KeyFilter::skipPrefix(std::string const& _prefix)
+{
+    m_prefixes.push_back(_prefix);
+    return *this;
+}
+
+KeyFilter& KeyFilter::skipKey(std::string const& _key)
+{
+    m_excluded.push_back(_key);
+    return *this;
+}
+
+KeyFilter& KeyFilter::includeTopLevel(std::string const& _key)
+{
+    m_topLevelIncluded.push_back(_key);
+    return *this;
+}
+
+std::string KeyFilter::id() const
+{
+    std::string id;
+    for (auto const& prefix : m_prefixes)
+        id += "prefix:" + prefix + "\n";
+    for (auto const& key : m_excluded)
+        id += "exclude:" + key + "\n";
+    for (auto const& key : m_topLevelIncluded)
+        id += "include:" + key + "\n";
+    return id;
+}
+
+bool KeyFilter::skips(char const* _key, size_t _size, size_t _depth) const
+{
+    for (auto const& prefix : m_prefixes)
+        if (prefix.size() <= _size && std::memcmp(prefix.data(), _key, prefix.size()) == 0)
+            return true;
+    if (matchAny(m_excluded, _key, _size))
+        return true;
+    return _depth == 0 && !m_topLevelIncluded.empty() && !matchAny(m_topLevelIncluded, _key, _size);
+}
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace dataobject
+{
+/// Object members dropped while json or yaml is converted to DataObject
+/// The parser skips the subtree of a dropped member without creating the DataObjects
+class KeyFilter
+{
+public:
+    /// Skip members with the key starting with _prefix at any level (e.g. "//" comments)
+    KeyFilter& skipPrefix(std::string const& _prefix);
+    /// Skip members with the key _key at any level
+    KeyFilter& skipKey(std::string const& _key);
+    /// Read only the listed members of the top level object
+    KeyFilter& includeTopLevel(std::string const& _key);
+
+    bool empty() const
+    {
+        return m_prefixes.empty() && m_excluded.empty() && m_topLevelIncluded.empty();
+    }
+
+    /// Text that differs for the filters skipping different keys
+    std::string id() const;
+
+    /// Return true if member _key of _size chars is skipped
+    /// _depth is the depth of the object holding the member, 0 for the top level object
+    bool skips(char const* _key, size_t _size, size_t _depth) const;
+    bool skips(std::string const& _key, size_t _depth) const
+    {
+        return skips(_key.data(), _key.size(), _depth);
+    }
+
+private:
+    std::vector<std::string> m_prefixes;
+    std::vector<std::string> m_excluded;
+    std::vector<std::string> m_topLevelIncluded;
+};
+}
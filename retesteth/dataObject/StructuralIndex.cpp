@@ -0,0 +1,172 @@
+#include <dataObject/Exception.h>
+#include <dataObject/StructuralIndex.h>
+#include <cstring>
+#include <limits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+size_t const c_blockSize = 64;
+
+// Bit i of the mask is set if char i of the 64 byte block is of that class
+struct BlockMasks
+{
+    uint64_t quote = 0;
+    uint64_t op = 0;  // { } [ ] : ,
+    uint64_t space = 0;
+};
+
+#if defined(__AVX2__)
+size_t const c_laneSize = 32;
+typedef __m256i Lane;
+inline Lane loadLane(char const* _data)
+{
+    return _mm256_loadu_si256(reinterpret_cast<Lane const*>(_data));
+}
+inline Lane foldBrackets(Lane _lane)
+{
+    return _mm256_or_si256(_lane, _mm256_set1_epi8(0x20));
+}
+inline uint64_t matchLane(Lane _lane, char _ch)
+{
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_lane, _mm256_set1_epi8(_ch))));
+}
+#elif defined(__SSE2__)
+size_t const c_laneSize = 16;
+typedef __m128i Lane;
+inline Lane loadLane(char const* _data)
+{
+    return _mm_loadu_si128(reinterpret_cast<Lane const*>(_data));
+}
+inline Lane foldBrackets(Lane _lane)
+{
+    return _mm_or_si128(_lane, _mm_set1_epi8(0x20));
+}
+inline uint64_t matchLane(Lane _lane, char _ch)
+{
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_lane, _mm_set1_epi8(_ch))));
+}
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+void classifyBlock(char const* _block, BlockMasks& _masks)
+{
+    for (size_t offset = 0; offset < c_blockSize; offset += c_laneSize)
+    {
+        Lane const lane = loadLane(_block + offset);
+        Lane const folded = foldBrackets(lane);  // '[' -> '{', ']' -> '}'
+        uint64_t const op = matchLane(folded, '{') | matchLane(folded, '}') |
+                            matchLane(lane, ':') | matchLane(lane, ',');
+        uint64_t const space = matchLane(lane, ' ') | matchLane(lane, '\n') |
+                               matchLane(lane, '\r') | matchLane(lane, '\t');
+        _masks.quote |= matchLane(lane, '"') << offset;
+        _masks.op |= op << offset;
+        _masks.space |= space << offset;
+    }
+}
+#else
+void classifyBlock(char const* _block, BlockMasks& _masks)
+{
+    for (size_t i = 0; i < c_blockSize; i++)
+    {
+        uint64_t const bit = uint64_t(1) << i;
+        switch (_block[i])
+        {
+        case '"':
+            _masks.quote |= bit;
+            break;
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+            _masks.op |= bit;
+            break;
+        case ' ':
+        case '\n':
+        case '\r':
+        case '\t':
+            _masks.space |= bit;
+            break;
+        default:
+            break;
+        }
+    }
+}
+#endif
+
+// Bit i of the result is the xor of bits 0..i of _mask
+inline uint64_t prefixXor(uint64_t _mask)
+{
+    _mask ^= _mask << 1;
+    _mask ^= _mask << 2;
+    _mask ^= _mask << 4;
+    _mask ^= _mask << 8;
+    _mask ^= _mask << 16;
+    _mask ^= _mask << 32;
+    return _mask;
+}
+
+inline unsigned trailingZeros(uint64_t _mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(_mask);
+#else
+    unsigned count = 0;
+    while (!(_mask & 1))
+    {
+        _mask >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+}  // namespace
+
+namespace dataobject
+{
+void BuildStructuralIndex(char const* _data, size_t _size, std::vector<uint32_t>& _index)
+{
+    if (_size > std::numeric_limits<uint32_t>::max())
+        throw DataObjectException() << "Error parsing json: input is too large!";
+
+    _index.clear();
+    _index.reserve(_size / 8);
+
+    uint64_t inString = 0;    // all bits set if previous block ended inside of a string
+    uint64_t afterToken = 0;  // 1 if previous block ended with a number or literal char
+    char tail[c_blockSize];
+    for (size_t blockStart = 0; blockStart < _size; blockStart += c_blockSize)
+    {
+        BlockMasks masks;
+        if (_size - blockStart >= c_blockSize)
+            classifyBlock(_data + blockStart, masks);
+        else
+        {
+            std::memset(tail, ' ', c_blockSize);
+            std::memcpy(tail, _data + blockStart, _size - blockStart);
+            classifyBlock(tail, masks);
+        }
+
+        // opening quote and the string content, closing quote excluded
+        uint64_t const strings = prefixXor(masks.quote) ^ inString;
+        inString = 0 - (strings >> 63);
+
+        uint64_t const other = ~(masks.quote | masks.op | masks.space | strings);
+        uint64_t const otherStart = other & ~((other << 1) | afterToken);
+        afterToken = other >> 63;
+
+        uint64_t tokens = masks.quote | (masks.op & ~strings) | otherStart;
+        while (tokens)
+        {
+            _index.push_back(static_cast<uint32_t>(blockStart + trailingZeros(tokens)));
+            tokens &= tokens - 1;
+        }
+    }
+}
+}
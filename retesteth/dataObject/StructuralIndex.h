@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dataobject
+{
+/// First stage of the json parser
+/// Record positions of the json tokens found in _data into _index:
+/// structural chars { } [ ] : , outside of strings, both quotes of every string
+/// and the first char of every other token (numbers, true, false, null)
+/// Input is classified in 64 byte blocks with SSE2/AVX2 when the compiler targets it
+/// A string is read till the next quote char (escape sequences are kept as is)
+void BuildStructuralIndex(char const* _data, size_t _size, std::vector<uint32_t>& _index);
+}
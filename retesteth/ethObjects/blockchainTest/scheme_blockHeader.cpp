@@ -6,7 +6,7 @@ scheme_blockHeader::scheme_blockHeader(DataObject const& _data) : object(_data)
     // Traditional Block Header
     if (_data.count("bloom"))
     {
-        requireJsonFields(_data, "blockchainTest::blockHeader filled " + _data.getKey(),
+        static JsonSchema const filledSchema(
             {{"bloom", {{DataType::String}, jsonField::Required}},
                 {"coinbase", {{DataType::String}, jsonField::Required}},
                 {"difficulty", {{DataType::String}, jsonField::Required}},
@@ -23,15 +23,19 @@ scheme_blockHeader::scheme_blockHeader(DataObject const& _data) : object(_data)
                 {"timestamp", {{DataType::String}, jsonField::Required}},
                 {"transactionsTrie", {{DataType::String}, jsonField::Required}},
                 {"uncleHash", {{DataType::String}, jsonField::Required}}});
+        requireJsonFields(
+            _data, "blockchainTest::blockHeader filled " + _data.getKey(), filledSchema);
     }
     else
     {
         // Genesis block header
-        requireJsonFields(_data, "blockchainTest::blockHeader filler " + _data.getKey(),
+        static JsonSchema const fillerSchema(
             {{"author", {DataType::String}}, {"difficulty", {DataType::String}},
                 {"gasLimit", {DataType::String}}, {"nonce", {DataType::String}},
                 {"extraData", {DataType::String}}, {"timestamp", {DataType::String}},
                 {"mixHash", {DataType::String}}});
+        requireJsonFields(
+            _data, "blockchainTest::blockHeader filler " + _data.getKey(), fillerSchema);
         m_data.renameKey("author", "coinbase");
     }
 }
@@ -4,7 +4,7 @@ using namespace test;
 
 scheme_blockchainTestBase::fieldChecker::fieldChecker(DataObject const& _test)
 {
-    requireJsonFields(_test, "blockchainTest " + _test.getKey(),
+    static JsonSchema const schema(
         {{"_info", {{DataType::Object}, jsonField::Optional}},
             {"blocks", {{DataType::Array}, jsonField::Required}},
             {"expect", {{DataType::Array}, jsonField::Optional}},
@@ -17,11 +17,12 @@ scheme_blockchainTestBase::fieldChecker::fieldChecker(DataObject const& _test)
             {"postState", {{DataType::Object, DataType::String}, jsonField::Optional}},
             {"pre", {{DataType::Object}, jsonField::Required}},
             {"sealEngine", {{DataType::String}, jsonField::Optional}}});
+    requireJsonFields(_test, "blockchainTest " + _test.getKey(), schema);
 }
 
 scheme_blockchainTest::fieldChecker::fieldChecker(DataObject const& _test)
 {
-    requireJsonFields(_test, "blockchainTest " + _test.getKey(),
+    static JsonSchema const schema(
         {{"_info", {{DataType::Object}, jsonField::Required}},
             {"blocks", {{DataType::Array}, jsonField::Required}},
             {"genesisBlockHeader", {{DataType::Object}, jsonField::Required}},
@@ -31,6 +32,7 @@ scheme_blockchainTest::fieldChecker::fieldChecker(DataObject const& _test)
             {"postState", {{DataType::Object, DataType::String}, jsonField::Required}},
             {"pre", {{DataType::Object}, jsonField::Required}},
             {"sealEngine", {{DataType::String}, jsonField::Optional}}});
+    requireJsonFields(_test, "blockchainTest " + _test.getKey(), schema);
 }
 
 scheme_blockchainTestBase::scheme_blockchainTestBase(DataObject const& _test)
@@ -60,7 +62,8 @@ scheme_blockchainTest::scheme_blockchainTest(DataObject const& _test)
 DataObject scheme_blockchainTestBase::getGenesisForRPC(string const& _network) const
 {
     string net = (_network.empty() ? getData().atKey("network").asString() : _network);
-    DataObject genesis = prepareGenesisParams(net, m_sealEngine);
+    Fork const fork = networkFork(net);
+    DataObject genesis = prepareGenesisParams(fork, m_sealEngine);
 
     DataObject data;
     data["author"] = m_genesisHeader.getData().atKey("coinbase");
@@ -73,6 +76,6 @@ DataObject scheme_blockchainTestBase::getGenesisForRPC(string const& _network) c
     object::makeAllFieldsHex(data);
 
     genesis["genesis"] = data;
-    genesis["accounts"] = m_pre.getDataForRPC(net);
+    genesis["accounts"] = m_pre.getDataForRPC(fork);
     return genesis;
 }
@@ -3,13 +3,14 @@ using namespace test;
 
 scheme_blockchainTestFiller::fieldChecker::fieldChecker(DataObject const& _test)
 {
-    requireJsonFields(_test, "blockchainTest " + _test.getKey(),
+    static JsonSchema const schema(
         {{"_info", {{DataType::Object}, jsonField::Optional}},
             {"blocks", {{DataType::Array}, jsonField::Required}},
             {"expect", {{DataType::Array}, jsonField::Required}},
             {"genesisBlockHeader", {{DataType::Object}, jsonField::Required}},
             {"pre", {{DataType::Object}, jsonField::Required}},
             {"sealEngine", {{DataType::String}, jsonField::Optional}}});
+    requireJsonFields(_test, "blockchainTest " + _test.getKey(), schema);
 }
 
 scheme_blockchainTestFiller::scheme_blockchainTestFiller(DataObject const& _test)
@@ -21,12 +22,13 @@ scheme_blockchainTestFiller::scheme_blockchainTestFiller(DataObject const& _test
 
 scheme_blockchainTestFiller::blockSection::blockSection(DataObject const& _data)
 {
-    requireJsonFields(_data, "blockchainTest blocks section",
+    static JsonSchema const blockSchema(
         {{"blockHeader", {{DataType::Object}, jsonField::Optional}},
             {"blockHeaderPremine", {{DataType::Object}, jsonField::Optional}},
             {"blocknumber", {{DataType::String}, jsonField::Optional}},
             {"transactions", {{DataType::Array}, jsonField::Required}},
             {"uncleHeaders", {{DataType::Array}, jsonField::Required}}});
+    requireJsonFields(_data, "blockchainTest blocks section", blockSchema);
 
     for (auto const& tr : _data.atKey("transactions").getSubObjects())
     {
@@ -1,8 +1,10 @@
 #pragma once
+#include "../forks.h"
 #include "../object.h"
 #include "scheme_expectState.h"
 #include <retesteth/Options.h>
 #include <retesteth/TestHelper.h>
+#include <boost/dynamic_bitset.hpp>
 
 namespace test
 {
@@ -32,13 +34,9 @@ public:
     /// Correct expect section mining reward when filling the blockchain tests out of state
     /// tests State tests does not count mining rewards, but it is possible to generate a
     /// blockchain test out of it
-    void correctMiningReward(std::string const& _net, std::string const& _coinbaseAddress)
+    void correctMiningReward(Fork _fork, std::string const& _coinbaseAddress)
     {
-        u256 balance = 5000000000000000000;
-        if (_net == "Byzantium")
-            balance = 3000000000000000000;
-        if (_net == "Constantinople" || _net == "ConstantinopleFix")
-            balance = 2000000000000000000;
+        u256 const balance = forkInfo(_fork).blockReward;
         if (getExpectState().hasBalance(_coinbaseAddress))
         {
             u256 origBalance = u256(getExpectState().getBalance(_coinbaseAddress));
@@ -46,34 +44,55 @@ public:
         }
     }
 
-    bool checkIndexes(int _d, int _g, int _v) const
+    /// Transaction indexes of the section as bitmasks of the data, gas and value indexes
+    struct IndexMasks
+    {
+        boost::dynamic_bitset<> data;
+        boost::dynamic_bitset<> gas;
+        boost::dynamic_bitset<> value;
+    };
+    IndexMasks getIndexMasks(size_t _dataCount, size_t _gasCount, size_t _valueCount) const
     {
         ETH_ERROR_REQUIRE_MESSAGE(m_dataIndexes.size() != 0,
-            "checkIndexes() must not be called for blockchain expect section!");
-        if ((m_dataIndexes.count(_d) || m_dataIndexes.count(-1)) &&
-            (m_gasIndexes.count(_g) || m_gasIndexes.count(-1)) &&
-            (m_valueIndexes.count(_v) || m_valueIndexes.count(-1)))
-            return true;
-        return false;
+            "getIndexMasks() must not be called for blockchain expect section!");
+        IndexMasks masks;
+        masks.data = makeIndexMask(m_dataIndexes, _dataCount);
+        masks.gas = makeIndexMask(m_gasIndexes, _gasCount);
+        masks.value = makeIndexMask(m_valueIndexes, _valueCount);
+        return masks;
     }
 
 private:
+    // Index -1 stands for all indexes, indexes out of range are ignored
+    static boost::dynamic_bitset<> makeIndexMask(std::set<int> const& _indexes, size_t _count)
+    {
+        boost::dynamic_bitset<> mask(_count);
+        if (_indexes.count(-1))
+            return mask.set();
+        for (int index : _indexes)
+            if (index >= 0 && size_t(index) < _count)
+                mask.set(index);
+        return mask;
+    }
+
     class fieldChecker
     {
     public:
         fieldChecker(DataObject const& _expect)
         {
-            requireJsonFields(_expect, "expect",
+            static JsonSchema const expectSchema(
                 {{"indexes", {{DataType::Object}, jsonField::Optional}},
                     {"network", {{DataType::Array, DataType::String}, jsonField::Required}},
                     {"result", {{DataType::Object}, jsonField::Required}}});
+            requireJsonFields(_expect, "expect", expectSchema);
 
             if (_expect.count("indexes"))
             {
-                requireJsonFields(_expect.atKey("indexes"), "indexes",
+                static JsonSchema const indexesSchema(
                     {{"data", {DataType::Array, DataType::Integer}},
                         {"gas", {DataType::Array, DataType::Integer}},
                         {"value", {DataType::Array, DataType::Integer}}});
+                requireJsonFields(_expect.atKey("indexes"), "indexes", indexesSchema);
             }
         }
     };
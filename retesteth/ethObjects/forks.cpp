@@ -0,0 +1,42 @@
+#include "forks.h"
+#include <retesteth/EthChecks.h>
+
+namespace test {
+namespace
+{
+// Adding a network is adding its entry here, in the order of the Fork enum
+constexpr ForkInfo c_forks[] = {
+    {Fork::Frontier, "Frontier", nullptr, 4, 5000000000000000000},
+    {Fork::Homestead, "Homestead", "homesteadForkBlock", 4, 5000000000000000000},
+    {Fork::EIP150, "EIP150", "EIP150ForkBlock", 4, 5000000000000000000},
+    {Fork::EIP158, "EIP158", "EIP158ForkBlock", 4, 5000000000000000000},
+    {Fork::Byzantium, "Byzantium", "byzantiumForkBlock", 8, 3000000000000000000},
+    {Fork::Constantinople, "Constantinople", "constantinopleForkBlock", 8, 2000000000000000000},
+    {Fork::ConstantinopleFix, "ConstantinopleFix", "constantinopleFixForkBlock", 8,
+        2000000000000000000}};
+size_t const c_forkCount = sizeof(c_forks) / sizeof(c_forks[0]);
+static_assert(c_forkCount == size_t(Fork::ConstantinopleFix) + 1,
+    "c_forks must have an entry for every Fork");
+
+// forkInfo(Fork) takes the entry at the position of the fork
+constexpr bool inForkOrder(size_t _i = 0)
+{
+    return _i == c_forkCount || (c_forks[_i].fork == Fork(_i) && inForkOrder(_i + 1));
+}
+static_assert(inForkOrder(), "c_forks must be in the order of the Fork enum");
+}  // namespace
+
+Fork toFork(std::string const& _network)
+{
+    for (auto const& info : c_forks)
+        if (_network == info.name)
+            return info.fork;
+    ETH_FAIL_MESSAGE("Unhandled network: " + _network);
+    return Fork::Frontier;
+}
+
+ForkInfo const& forkInfo(Fork _fork)
+{
+    return c_forks[size_t(_fork)];
+}
+}  // namespace test
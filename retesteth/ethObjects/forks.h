@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace test {
+/// Hard forks of the networks that genesis is prepared for, in the order of activation
+enum class Fork
+{
+    Frontier,
+    Homestead,
+    EIP150,
+    EIP158,
+    Byzantium,
+    Constantinople,
+    ConstantinopleFix
+};
+
+/// Genesis configuration of a network. Each network enables the rules of all forks before it
+struct ForkInfo
+{
+    Fork fork;
+    char const* name;
+    char const* forkBlockParam;   // genesis param that activates this fork, nullptr for Frontier
+    size_t precompiledCount;      // precompiled accounts 0x..01 to 0x..<count>
+    uint64_t blockReward;         // wei
+};
+
+/// Fork of the network _network. Fails on the networks that are not in the table
+/// Network names are converted once where they are checked, the rest of the code uses Fork
+Fork toFork(std::string const& _network);
+ForkInfo const& forkInfo(Fork _fork);
+}  // namespace test
@@ -1,50 +1,82 @@
 #include "object.h"
 #include "Options.h"
 #include <retesteth/TestHelper.h>
-#include <mutex>
+#include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace test {
 
-std::mutex g_strFindMutex;
-object::DigitsType object::stringIntegerType(std::string const& _string)
+namespace
 {
-    if (_string[0] == '0' && _string[1] == 'x')
-    {
-        string substring = _string.substr(2);
-        DigitsType substringType = stringIntegerType(substring);
-        if (substringType == DigitsType::Hex)
-            return DigitsType::HexPrefixed;
+uint8_t const c_hexDigit = 1;
+uint8_t const c_decimalDigit = 2;
 
-        if (substringType == DigitsType::Decimal)
-        {
-            if (substring.size() % 2 == 0)
-                return DigitsType::HexPrefixed;
-            else
-                return DigitsType::UnEvenHexPrefixed;
-        }
+// c_hexDigit | c_decimalDigit flags of every char
+constexpr uint8_t c_digitTable[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 0, 0, 0, 0, 0, 0,
+    0, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
 
-        if (substringType == DigitsType::UnEvenHex)
-            return DigitsType::UnEvenHexPrefixed;
+// Flags that all of _size chars of _data have
+uint8_t digitsOf(char const* _data, size_t _size)
+{
+    uint8_t digits = c_hexDigit | c_decimalDigit;
+    size_t i = 0;
+#if defined(__SSE2__)
+    // 16 chars at once for the long hex strings (code, storage, hashes)
+    for (; i + 16 <= _size; i += 16)
+    {
+        __m128i const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_data + i));
+        __m128i const lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+        __m128i const decimal = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)),
+            _mm_cmplt_epi8(chunk, _mm_set1_epi8('9' + 1)));
+        __m128i const letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+            _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+        if (_mm_movemask_epi8(_mm_or_si128(decimal, letter)) != 0xFFFF)
+            return 0;
+        if (_mm_movemask_epi8(decimal) != 0xFFFF)
+            digits &= ~c_decimalDigit;
     }
+#endif
+    for (; i < _size && digits; i++)
+        digits &= c_digitTable[static_cast<unsigned char>(_data[i])];
+    return digits;
+}
+}  // namespace
 
-    bool isDecimalOnly = true;
-    std::lock_guard<std::mutex> lock(
-        g_strFindMutex); // string.find is not thread safe + static
-    static std::string hexAlphabet = "0123456789abcdefABCDEF";
-    static std::string decimalAlphabet = "0123456789";
-    for (size_t i = 0; i < _string.length(); i++)
-    {
-        if (hexAlphabet.find(_string[i]) == std::string::npos)
-           return DigitsType::String;
+object::DigitsType object::stringIntegerType(std::string const& _string)
+{
+    bool const prefixed = _string.size() >= 2 && _string[0] == '0' && _string[1] == 'x';
+    size_t const start = prefixed ? 2 : 0;
+    size_t const size = _string.size() - start;
+    uint8_t const digits = digitsOf(_string.data() + start, size);
+    if (!(digits & c_hexDigit))
+        return DigitsType::String;
 
-        if (decimalAlphabet.find(_string[i]) == std::string::npos)
-            isDecimalOnly = false;
-    }
+    // 0x prefixed decimal digits are hex
+    if (prefixed)
+        return size % 2 == 0 ? DigitsType::HexPrefixed : DigitsType::UnEvenHexPrefixed;
 
-    if (isDecimalOnly)
+    if (digits & c_decimalDigit)
         return DigitsType::Decimal;
 
-    if (_string.size() % 2 == 0)
+    if (size % 2 == 0)
         return DigitsType::Hex;
 
     return DigitsType::UnEvenHex;
@@ -131,160 +163,147 @@ void object::makeAllFieldsHex(DataObject& _data)
         makeKeyHex(_data);
 }
 
-void requireJsonFields(DataObject const& _o, std::string const& _section,
-    std::map<std::string, possibleType> const& _validationMap, bool _fail)
+JsonSchema::JsonSchema(std::map<std::string, possibleType> const& _validationMap)
+  : m_configMessages(false)
 {
-    // check for unexpected fiedls
-    for (auto const field : _o.getSubObjects())
-    {
-        string message =
-            "'" + field.getKey() + "' should not be declared in '" + _section + "' section!";
-        if (_fail)
-            ETH_FAIL_REQUIRE_MESSAGE(_validationMap.count(field.getKey()), message);
-        else
-            ETH_ERROR_REQUIRE_MESSAGE(_validationMap.count(field.getKey()), message);
-    }
+    for (auto const& field : _validationMap)
+        addField(field.first, field.second, true);
+}
 
-    // check field types with validation map
-    for (auto const vmap : _validationMap)
+JsonSchema::JsonSchema(std::map<std::string, jsonType> const& _validationMap)
+  : m_configMessages(true)
+{
+    for (auto const& field : _validationMap)
+        addField(field.first, field.second.first, field.second.second == jsonField::Required);
+}
+
+void JsonSchema::addField(
+    std::string const& _name, std::set<DataType> const& _types, bool _required)
+{
+    assert(m_fields.size() < 64);
+    Field field;
+    field.name = _name;
+    field.types = 0;
+    for (auto const& type : _types)
+        field.types |= 1u << type;
+    field.required = _required;
+    if (_required)
+        m_requiredMask |= uint64_t(1) << m_fields.size();
+    m_fields.push_back(field);  // std::map gives the fields in sorted order
+}
+
+size_t JsonSchema::find(std::string const& _name) const
+{
+    auto const it = std::lower_bound(m_fields.begin(), m_fields.end(), _name,
+        [](Field const& _field, std::string const& _name) { return _field.name < _name; });
+    if (it == m_fields.end() || it->name != _name)
+        return m_fields.size();
+    return it - m_fields.begin();
+}
+
+namespace
+{
+std::string typesAsString(unsigned _types, std::string const& _separator)
+{
+    std::string sTypes;
+    for (unsigned type = 0; type <= DataType::Null; type++)
     {
-        string message = vmap.first + " not found in " + _section + " section! " +
-                         TestOutputHelper::get().testName();
-        if (_fail)
-            ETH_FAIL_REQUIRE_MESSAGE(_o.count(vmap.first) > 0, message);
-        else
-            ETH_ERROR_REQUIRE_MESSAGE(_o.count(vmap.first) > 0, message);
-        bool matched = false;
-        std::string sTypes;
-        for (auto const& type : vmap.second)
-        {
-            if (sTypes.size())
-                sTypes += " or ";
-            sTypes += DataObject::dataTypeAsString(type);
-            if (_o.atKey(vmap.first).type() == type)
-                matched = true;
-        }
-        if (matched == false)
-        {
-            std::string comment = _section + " '" + vmap.first + "' expected to be '" + sTypes +
-                                  "', but set to: '" +
-                                  DataObject::dataTypeAsString(_o.atKey(vmap.first).type()) +
-                                  "' in " + TestOutputHelper::get().testName();
-            if (_fail)
-                ETH_FAIL_MESSAGE(comment + "\n" + _o.asJson());
-            else
-                ETH_ERROR_MESSAGE(comment + "\n" + _o.asJson());
-        }
+        if (!(_types & (1u << type)))
+            continue;
+        if (sTypes.size())
+            sTypes += _separator;
+        sTypes += DataObject::dataTypeAsString(static_cast<DataType>(type));
     }
+    return sTypes;
+}
+
+void reportError(std::string const& _message, bool _fail)
+{
+    if (_fail)
+        ETH_FAIL_MESSAGE(_message);
+    else
+        ETH_ERROR_MESSAGE(_message);
 }
+}  // namespace
 
-void requireJsonFields(DataObject const& _o, std::string const& _config,
-    std::map<std::string, jsonType> const& _validationMap)
+void requireJsonFields(
+    DataObject const& _o, std::string const& _section, JsonSchema const& _schema, bool _fail)
 {
-    // check for unexpected fiedls
+    // single pass over the members, messages are made only if there is an error
+    uint64_t found = 0;
+    uint64_t wrongType = 0;
     for (auto const& field : _o.getSubObjects())
     {
-        if (!_validationMap.count(field.getKey()))
+        size_t const index = _schema.find(field.getKey());
+        if (index == _schema.m_fields.size())
         {
-            std::string const comment =
-                "Unexpected field '" + field.getKey() + "' in config: " + _config;
-            ETH_ERROR_MESSAGE(comment + "\n" + _o.asJson());
+            // check for unexpected fiedls
+            if (_schema.m_configMessages)
+                reportError("Unexpected field '" + field.getKey() + "' in config: " + _section +
+                                "\n" + _o.asJson(),
+                    _fail);
+            else
+                reportError("'" + field.getKey() + "' should not be declared in '" + _section +
+                                "' section!",
+                    _fail);
+            continue;
         }
+        found |= uint64_t(1) << index;
+        if (!(_schema.m_fields.at(index).types & (1u << field.type())))
+            wrongType |= uint64_t(1) << index;
     }
+    if ((found & _schema.m_requiredMask) == _schema.m_requiredMask && !wrongType)
+        return;
 
-    // check field types with validation map
-    for (auto const vmap : _validationMap)
+    // report the first missing or mistyped field in the field name order
+    for (size_t i = 0; i < _schema.m_fields.size(); i++)
     {
-        // check that all required fields are in the object
-        if (!_o.count(vmap.first))
+        JsonSchema::Field const& field = _schema.m_fields.at(i);
+        uint64_t const bit = uint64_t(1) << i;
+        if (!(found & bit) && field.required)
         {
-            if (vmap.second.second == jsonField::Required)
-            {
-                std::string const comment =
-                    "Expected field '" + vmap.first + "' not found in config: " + _config;
-                ETH_ERROR_MESSAGE(comment + "\n" + _o.asJson());
-            }
-            else if (vmap.second.second == jsonField::Optional)
-                continue;
-        }
-
-        // check that field type is one of allowed field types
-        bool matched = false;
-        for (auto const& type : vmap.second.first)
-        {
-            if (_o.atKey(vmap.first).type() == type)
-                matched = true;
+            if (_schema.m_configMessages)
+                reportError("Expected field '" + field.name + "' not found in config: " +
+                                _section + "\n" + _o.asJson(),
+                    _fail);
+            else
+                reportError(field.name + " not found in " + _section + " section! " +
+                                TestOutputHelper::get().testName(),
+                    _fail);
         }
-        if (matched == false)
+        else if (wrongType & bit)
         {
-            std::string sTypes;
-            for (auto const& type : vmap.second.first)
-            {
-                if (sTypes.size())
-                    sTypes += ", or ";
-                sTypes += DataObject::dataTypeAsString(type);
-            }
-            std::string const comment =
-                "Field '" + vmap.first + "' expected to be " + sTypes + ", but set to " +
-                DataObject::dataTypeAsString(_o.atKey(vmap.first).type()) + " in " + _config;
-            ETH_ERROR_MESSAGE(comment + "\n" + _o.asJson());
+            std::string const setTo = DataObject::dataTypeAsString(_o.atKey(field.name).type());
+            if (_schema.m_configMessages)
+                reportError("Field '" + field.name + "' expected to be " +
+                                typesAsString(field.types, ", or ") + ", but set to " + setTo +
+                                " in " + _section + "\n" + _o.asJson(),
+                    _fail);
+            else
+                reportError(_section + " '" + field.name + "' expected to be '" +
+                                typesAsString(field.types, " or ") + "', but set to: '" + setTo +
+                                "' in " + TestOutputHelper::get().testName() + "\n" +
+                                _o.asJson(),
+                    _fail);
         }
     }
 }
 
-
-DataObject object::prepareGenesisParams(std::string const& _network, std::string const& _engine)
+Fork object::networkFork(std::string const& _network)
 {
     ClientConfig const& cfg = Options::get().getDynamicOptions().getCurrentConfig();
     test::checkAllowedNetwork(_network, cfg.getNetworks());
-    bool networkChecked = false;
+    return toFork(_network);
+}
+
+DataObject object::prepareGenesisParams(Fork _fork, std::string const& _engine)
+{
+    ForkInfo const& network = forkInfo(_fork);
     DataObject genesis;
     genesis["sealEngine"] = _engine;
-    if (_network == "Frontier")
-    {
-        networkChecked = true;
-        genesis["params"] = DataObject(DataType::Object);
-    }
-    else if (_network == "Homestead")
-    {
-        networkChecked = true;
-        genesis["params"]["homesteadForkBlock"] = "0x00";
-    }
-    else if (_network == "EIP150")
-    {
-        networkChecked = true;
-        genesis["params"]["homesteadForkBlock"] = "0x00";
-        genesis["params"]["EIP150ForkBlock"] = "0x00";
-    }
-    else if (_network == "EIP158")
-    {
-        networkChecked = true;
-        genesis["params"]["homesteadForkBlock"] = "0x00";
-        genesis["params"]["EIP150ForkBlock"] = "0x00";
-        genesis["params"]["EIP158ForkBlock"] = "0x00";
-    }
-    else if (_network == "Byzantium")
-    {
-        networkChecked = true;
-        genesis["params"]["homesteadForkBlock"] = "0x00";
-        genesis["params"]["EIP150ForkBlock"] = "0x00";
-        genesis["params"]["EIP158ForkBlock"] = "0x00";
-        genesis["params"]["byzantiumForkBlock"] = "0x00";
-    }
-    else if (_network == "Constantinople" || _network == "ConstantinopleFix")
-    {
-        networkChecked = true;
-        genesis["params"]["homesteadForkBlock"] = "0x00";
-        genesis["params"]["EIP150ForkBlock"] = "0x00";
-        genesis["params"]["EIP158ForkBlock"] = "0x00";
-        genesis["params"]["byzantiumForkBlock"] = "0x00";
-        genesis["params"]["constantinopleForkBlock"] = "0x00";
-        if (_network == "ConstantinopleFix")
-            genesis["params"]["constantinopleFixForkBlock"] = "0x00";
-    }
-    if (!networkChecked)
-        ETH_FAIL_MESSAGE(
-            "Unhandled network: " + _network + " (DataObject object::prepareGenesisParams)");
+    genesis["params"] = DataObject(DataType::Object);
+    for (size_t i = size_t(Fork::Homestead); i <= size_t(network.fork); i++)
+        genesis["params"][forkInfo(Fork(i)).forkBlockParam] = "0x00";
     return genesis;
 }
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include "forks.h"
 #include <dataObject/DataObject.h>
 #include <retesteth/EthChecks.h>
 #include <retesteth/TestOutputHelper.h>
@@ -24,8 +25,10 @@ namespace test {
 
             static DigitsType stringIntegerType(std::string const& _string);
             static std::string makeHexAddress(std::string const& _address);
+            /// Fork of the network _network, which must be allowed by the current client config
+            static Fork networkFork(std::string const& _network);
             static DataObject prepareGenesisParams(
-                std::string const& _network, std::string const& _engine = "NoProof");
+                Fork _fork, std::string const& _engine = "NoProof");
 
         protected:
             static void makeKeyHex(DataObject& _key);
@@ -39,8 +42,6 @@ namespace test {
 
 	/// check the presents of fields in a DataObject with a validation map
 	typedef std::set<DataType> possibleType;
-    void requireJsonFields(DataObject const& _o, std::string const& _section,
-        std::map<std::string, possibleType> const& _validationMap, bool _fail = false);
 
     enum jsonField
     {
@@ -49,15 +50,43 @@ namespace test {
     };
     using jsonTypeSet = std::set<DataType>;
     using jsonType = std::pair<jsonTypeSet, jsonField>;
-    //! Check the json object with validation map that reuires certain field of certain type to be
-    //! present in json
+
+    /// Validation map compiled into a table of the field names in sorted order
+    /// with the allowed field types as a bitmask. Make it once (static) and reuse it
+    class JsonSchema
+    {
+    public:
+        /// All fields are required, errors are reported as for a test section
+        explicit JsonSchema(std::map<std::string, possibleType> const& _validationMap);
+        /// Errors are reported as for a config
+        explicit JsonSchema(std::map<std::string, jsonType> const& _validationMap);
+
+    private:
+        struct Field
+        {
+            std::string name;
+            unsigned types;  // bit (1 << DataType) is set for every allowed type
+            bool required;
+        };
+        void addField(std::string const& _name, std::set<DataType> const& _types, bool _required);
+        size_t find(std::string const& _name) const;
+
+        std::vector<Field> m_fields;
+        uint64_t m_requiredMask = 0;
+        bool m_configMessages;
+        friend void requireJsonFields(DataObject const& _o, std::string const& _section,
+            JsonSchema const& _schema, bool _fail);
+    };
+
+    //! Check the json object with validation schema that requires certain field of certain type
+    //! to be present in json. Members of the object are checked in a single pass
     /*!
       \param _o a json object to check
-      \param _configName a string with json object name. Will apper in error message.
-      \param _validationMap a map with json objects that would be checked. "objName" ->
-      {js::str_type, jsonField::Required}
+      \param _section a string with json object name. Will apper in error message.
+      \param _schema fields that would be checked. "objName" -> {js::str_type, jsonField::Required}
+      \param _fail fail the execution instead of the test
     */
-    void requireJsonFields(DataObject const& _o, std::string const& _configName,
-        std::map<std::string, jsonType> const& _validationMap);
+    void requireJsonFields(DataObject const& _o, std::string const& _section,
+        JsonSchema const& _schema, bool _fail = false);
 }
 
@@ -0,0 +1,213 @@
+#include "scheme_block.h"
+using namespace test;
+
+namespace
+{
+// Big-endian bytes of _value without the leading zeros written to _buffer,
+// the RLP of a number is the RLP of them
+bytesConstRef compact(u256 _value, h256& _buffer)
+{
+    size_t begin = h256::size;
+    while (_value != 0)
+    {
+        // 64 bits at once, the shifts of u256 are slow
+        uint64_t word = static_cast<uint64_t>(_value & std::numeric_limits<uint64_t>::max());
+        _value >>= 64;
+        for (size_t i = 0; i < 8 && (word != 0 || _value != 0); i++, word >>= 8)
+            _buffer[--begin] = byte(word);
+    }
+    return bytesConstRef(_buffer.data() + begin, h256::size - begin);
+}
+
+size_t itemSize(bytesConstRef _item)
+{
+    if (_item.size() == 1 && _item[0] < c_rlpDataImmLenStart)
+        return 1;
+    if (_item.size() < c_rlpDataImmLenCount)
+        return 1 + _item.size();
+    return 1 + bytesRequired(_item.size()) + _item.size();
+}
+
+size_t listSize(size_t _payloadSize)
+{
+    if (_payloadSize < c_rlpListImmLenCount)
+        return 1 + _payloadSize;
+    return 1 + bytesRequired(_payloadSize) + _payloadSize;
+}
+
+// Writes RLP items into a buffer reserved for the whole block
+class RLPBuffer
+{
+public:
+    explicit RLPBuffer(size_t _size) { m_out.reserve(_size); }
+
+    void appendItem(bytesConstRef _item)
+    {
+        if (_item.size() == 1 && _item[0] < c_rlpDataImmLenStart)
+            m_out.push_back(_item[0]);
+        else
+        {
+            appendPrefix(_item.size(), c_rlpDataImmLenStart, c_rlpDataIndLenZero);
+            m_out.insert(m_out.end(), _item.begin(), _item.end());
+        }
+    }
+    void appendList(size_t _payloadSize)
+    {
+        appendPrefix(_payloadSize, c_rlpListStart, c_rlpListIndLenZero);
+    }
+    bytes const& out() const { return m_out; }
+
+private:
+    // Short prefix is _start + size, long prefix is _indLenZero + size of size, then size
+    void appendPrefix(size_t _size, byte _start, byte _indLenZero)
+    {
+        if (_size < size_t(_indLenZero - _start + 1))
+        {
+            m_out.push_back(byte(_start + _size));
+            return;
+        }
+        size_t const sizeBytes = bytesRequired(_size);
+        m_out.push_back(byte(_indLenZero + sizeBytes));
+        for (size_t i = sizeBytes; i > 0; i--)
+            m_out.push_back(byte(_size >> (8 * (i - 1))));
+    }
+
+    bytes m_out;
+};
+
+// Calls _f with the items of the header in the order of the block RLP
+template <class F>
+void forEachItem(scheme_block::HeaderFields const& _header, F const& _f)
+{
+    h256 number;
+    _f(_header.parentHash.ref());
+    _f(_header.uncleHash.ref());
+    _f(_header.coinbase.ref());
+    _f(_header.stateRoot.ref());
+    _f(_header.transactionsRoot.ref());
+    _f(_header.receiptsRoot.ref());
+    _f(_header.bloom.ref());
+    _f(compact(_header.difficulty, number));
+    _f(compact(_header.number, number));
+    _f(compact(_header.gasLimit, number));
+    _f(compact(_header.gasUsed, number));
+    _f(compact(_header.timestamp, number));
+    _f(bytesConstRef(&_header.extraData));
+    _f(_header.mixHash.ref());
+    _f(_header.nonce.ref());
+}
+
+template <class F>
+void forEachItem(scheme_block::TransactionFields const& _tr, F const& _f)
+{
+    h256 number;
+    _f(compact(_tr.nonce, number));
+    _f(compact(_tr.gasPrice, number));
+    _f(compact(_tr.gas, number));
+    _f(_tr.isCreation ? bytesConstRef() : _tr.to.ref());
+    _f(compact(_tr.value, number));
+    _f(bytesConstRef(&_tr.data));
+    _f(compact(_tr.v, number));
+    _f(compact(_tr.r, number));
+    _f(compact(_tr.s, number));
+}
+
+template <class T>
+size_t payloadSize(T const& _fields)
+{
+    size_t size = 0;
+    forEachItem(_fields, [&size](bytesConstRef _item) { size += itemSize(_item); });
+    return size;
+}
+}  // namespace
+
+scheme_block::BlockFields const& scheme_block::getBlockFields() const
+{
+    if (m_blockFields)
+        return *m_blockFields;
+
+    std::shared_ptr<BlockFields> fields = std::make_shared<BlockFields>();
+    HeaderFields& header = fields->header;
+    header.parentHash = m_data.atKey("parentHash").asH256();
+    header.uncleHash = m_data.atKey("sha3Uncles").asH256();
+    header.coinbase = m_data.atKey("author").asH160();
+    header.stateRoot = m_data.atKey("stateRoot").asH256();
+    header.transactionsRoot = m_data.atKey("transactionsRoot").asH256();
+    header.receiptsRoot = m_data.atKey("receiptsRoot").asH256();
+    header.bloom = h2048(m_data.atKey("logsBloom").asString());
+    header.difficulty = m_data.atKey("difficulty").asU256();
+    header.number = m_data.atKey("number").asU256();
+    header.gasLimit = m_data.atKey("gasLimit").asU256();
+    header.gasUsed = m_data.atKey("gasUsed").asU256();
+    header.timestamp = m_data.atKey("timestamp").asU256();
+    header.extraData = dev::fromHex(m_data.atKey("extraData").asString());
+    if (m_data.count("mixHash"))
+    {
+        header.mixHash = m_data.atKey("mixHash").asH256();
+        header.nonce = h64(m_data.atKey("nonce").asString());
+    }
+
+    std::vector<DataObject> const& transactions = m_data.atKey("transactions").getSubObjects();
+    fields->transactions.resize(transactions.size());
+    for (size_t i = 0; i < transactions.size(); i++)
+    {
+        DataObject const& transaction = transactions.at(i);
+        TransactionFields& tr = fields->transactions.at(i);
+        tr.nonce = transaction.atKey("nonce").asU256();
+        tr.gasPrice = transaction.atKey("gasPrice").asU256();
+        tr.gas = transaction.atKey("gas").asU256();
+        tr.isCreation = transaction.atKey("to").type() == DataType::Null ||
+                        transaction.atKey("to").asString().empty();
+        if (!tr.isCreation)
+            tr.to = transaction.atKey("to").asH160();
+        tr.value = transaction.atKey("value").asU256();
+        tr.data = fromHex(transaction.atKey("input").asString());
+
+        byte v = (int)transaction.atKey("v").asU256();
+        if (v <= 1)
+        {
+            v += 27;  // To deal with Aleth's logic to subtract 27 from V when it is 27 or 28
+        }
+        tr.v = v;
+        tr.r = transaction.atKey("r").asU256();
+        tr.s = transaction.atKey("s").asU256();
+    }
+    m_blockFields = fields;
+    return *m_blockFields;
+}
+
+std::string scheme_block::getBlockRLP() const
+{
+    ETH_ERROR_REQUIRE_MESSAGE(m_isFullTransactions,
+        "Attempt to get blockRLP of a block received without full transactions!");
+    BlockFields const& fields = getBlockFields();
+
+    // RLP of a block
+    // rlpHead .. blockinfo transactions uncles
+    // The sizes are counted first so the RLP is written in one pass into a buffer of its size
+    size_t const headerSize = payloadSize(fields.header);
+    std::vector<size_t> trSizes;
+    trSizes.reserve(fields.transactions.size());
+    size_t trListSize = 0;
+    for (auto const& tr : fields.transactions)
+    {
+        trSizes.push_back(payloadSize(tr));
+        trListSize += listSize(trSizes.back());
+    }
+    size_t const uncleListSize = listSize(0);
+    size_t const blockSize = listSize(headerSize) + listSize(trListSize) + uncleListSize;
+
+    RLPBuffer rlp(listSize(blockSize));
+    auto const append = [&rlp](bytesConstRef _item) { rlp.appendItem(_item); };
+    rlp.appendList(blockSize);
+    rlp.appendList(headerSize);
+    forEachItem(fields.header, append);
+    rlp.appendList(trListSize);
+    for (size_t i = 0; i < fields.transactions.size(); i++)
+    {
+        rlp.appendList(trSizes.at(i));
+        forEachItem(fields.transactions.at(i), append);
+    }
+    rlp.appendList(0);  // empty uncle list
+    return dev::toHexPrefixed(rlp.out());
+}
@@ -2,6 +2,7 @@
 #include "../object.h"
 #include <libdevcore/Address.h>
 #include <libdevcore/RLP.h>
+#include <memory>
 using namespace dev;
 
 namespace test {
@@ -10,7 +11,7 @@ class scheme_block : public object
 public:
     scheme_block(DataObject const& _block) : object(_block)
     {
-        requireJsonFields(_block, "blockRPC",
+        static JsonSchema const schema(
             {{"author", {{DataType::String}, jsonField::Required}},
                 {"extraData", {{DataType::String}, jsonField::Required}},
                 {"gasLimit", {{DataType::String}, jsonField::Required}},
@@ -34,6 +35,7 @@ public:
                 {"seedHash", {{DataType::String}, jsonField::Optional}},
                 {"nonce", {{DataType::String}, jsonField::Optional}},
                 {"mixHash", {{DataType::String}, jsonField::Optional}}});
+        requireJsonFields(_block, "blockRPC", schema);
 
         if (m_data.atKey("transactions").getSubObjects().size())
             m_isFullTransactions =
@@ -44,16 +46,17 @@ public:
             return;
         }
 
+        static JsonSchema const transactionSchema(
+            {{"blockHash", {DataType::String}}, {"blockNumber", {DataType::String}},
+                {"from", {DataType::String}}, {"gas", {DataType::String}},
+                {"gasPrice", {DataType::String}}, {"hash", {DataType::String}},
+                {"input", {DataType::String}}, {"nonce", {DataType::String}},
+                {"to", {DataType::String, DataType::Null}}, {"v", {DataType::String}},
+                {"r", {DataType::String}}, {"s", {DataType::String}},
+                {"transactionIndex", {DataType::String}}, {"value", {DataType::String}}});
         if (m_isFullTransactions)
             for (auto const& trObj : m_data.atKey("transactions").getSubObjects())
-                requireJsonFields(trObj, "block rpc transaction element",
-                    {{"blockHash", {DataType::String}}, {"blockNumber", {DataType::String}},
-                        {"from", {DataType::String}}, {"gas", {DataType::String}},
-                        {"gasPrice", {DataType::String}}, {"hash", {DataType::String}},
-                        {"input", {DataType::String}}, {"nonce", {DataType::String}},
-                        {"to", {DataType::String, DataType::Null}}, {"v", {DataType::String}},
-                        {"r", {DataType::String}}, {"s", {DataType::String}},
-                        {"transactionIndex", {DataType::String}}, {"value", {DataType::String}}});
+                requireJsonFields(trObj, "block rpc transaction element", transactionSchema);
         else
             for (auto const& trObj : m_data.atKey("transactions").getSubObjects())
                 ETH_ERROR_REQUIRE_MESSAGE(trObj.type() == DataType::String,
@@ -102,76 +105,53 @@ public:
         return header;
     }
 
-    // Get Block RLP for state tests
-    std::string getBlockRLP() const
+    // Block fields in the types of the RLP encoding
+    struct HeaderFields
     {
-        ETH_ERROR_REQUIRE_MESSAGE(m_isFullTransactions,
-            "Attempt to get blockRLP of a block received without full transactions!");
-        // RLP of a block
-        // rlpHead .. blockinfo transactions uncles
-        RLPStream stream(3);
-        RLPStream header;
-        header.appendList(15);
-        header << h256(m_data.atKey("parentHash").asString());
-        header << h256(m_data.atKey("sha3Uncles").asString());
-        header << dev::Address(m_data.atKey("author").asString());
-        header << h256(m_data.atKey("stateRoot").asString());
-        header << h256(m_data.atKey("transactionsRoot").asString());
-        header << h256(m_data.atKey("receiptsRoot").asString());
-        header << h2048(m_data.atKey("logsBloom").asString());
-        header << u256(m_data.atKey("difficulty").asString());
-        header << u256(m_data.atKey("number").asString());
-        header << u256(m_data.atKey("gasLimit").asString());
-        header << u256(m_data.atKey("gasUsed").asString());
-        header << u256(m_data.atKey("timestamp").asString());
-        header << dev::fromHex(m_data.atKey("extraData").asString());
-        if (m_data.count("mixHash"))
-        {
-            header << h256(m_data.atKey("mixHash").asString());
-            header << h64(m_data.atKey("nonce").asString());
-        }
-        else
-        {
-            header << h256(0);
-            header << h64(0);
-        }
-        stream.appendRaw(header.out());
+        h256 parentHash;
+        h256 uncleHash;
+        Address coinbase;
+        h256 stateRoot;
+        h256 transactionsRoot;
+        h256 receiptsRoot;
+        h2048 bloom;
+        u256 difficulty;
+        u256 number;
+        u256 gasLimit;
+        u256 gasUsed;
+        u256 timestamp;
+        bytes extraData;
+        h256 mixHash;
+        h64 nonce;
+    };
+    struct TransactionFields
+    {
+        u256 nonce;
+        u256 gasPrice;
+        u256 gas;
+        bool isCreation;
+        Address to;
+        u256 value;
+        bytes data;
+        u256 v;
+        u256 r;
+        u256 s;
+    };
+    struct BlockFields
+    {
+        HeaderFields header;
+        std::vector<TransactionFields> transactions;
+    };
 
-        size_t trCount = m_data.atKey("transactions").getSubObjects().size();
-        RLPStream transactionList(trCount);
-        for (size_t i = 0; i < trCount; i++)
-        {
-            RLPStream transactionRLP(9);
-            DataObject transaction = m_data.atKey("transactions").getSubObjects().at(i);
-            transactionRLP << u256(transaction.atKey("nonce").asString());
-            transactionRLP << u256(transaction.atKey("gasPrice").asString());
-            transactionRLP << u256(transaction.atKey("gas").asString());
-            if (transaction.atKey("to").type() == DataType::Null ||
-                transaction.atKey("to").asString().empty())
-                transactionRLP << "";
-            else
-                transactionRLP << Address(transaction.atKey("to").asString());
-            transactionRLP << u256(transaction.atKey("value").asString());
-            transactionRLP << fromHex(transaction.atKey("input").asString());
+    /// Block fields parsed from the RPC reply once, shared by the copies of this object
+    BlockFields const& getBlockFields() const;
 
-            byte v = (int)u256(transaction.atKey("v").asString().c_str());
-            if (v <= 1)
-            {
-                v += 27;  // To deal with Aleth's logic to subtract 27 from V when it is 27 or 28
-            }
-            transactionRLP << v;
-            transactionRLP << u256(transaction.atKey("r").asString());
-            transactionRLP << u256(transaction.atKey("s").asString());
-            transactionList.appendRaw(transactionRLP.out());
-        }
-        stream.appendRaw(transactionList.out());
-        stream.appendRaw(RLPStream(0).out());  // empty uncle list
-
-        return dev::toHexPrefixed(stream.out());
-    }
+    // Get Block RLP for state tests
+    std::string getBlockRLP() const;
 
 private:
     bool m_isFullTransactions = false;
+    mutable std::shared_ptr<BlockFields const> m_blockFields;
 };
 }
 
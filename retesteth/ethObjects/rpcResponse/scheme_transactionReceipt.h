@@ -13,22 +13,10 @@ namespace test {
 		scheme_transactionReceipt(DataObject const& _receipt):
 			object(_receipt)
 		{
-			std::string statusField = "status";
-			if (_receipt.count("stateRoot"))
-				statusField = "stateRoot";
-
-			requireJsonFields(_receipt, "transactionReceipt", {
-					{"blockHash", {DataType::String} },
-					{"blockNumber", {DataType::Integer} },
-					{"contractAddress", {DataType::String} },
-					{"cumulativeGasUsed", {DataType::String} },
-					{"gasUsed", {DataType::String} },
-					{"logs", {DataType::Array} },
-					{"logsBloom", {DataType::String} },
-					{statusField, {DataType::String} },
-					{"transactionHash", {DataType::String} },
-					{"transactionIndex", {DataType::Integer} }
-				});
+			static JsonSchema const statusSchema = receiptSchema("status");
+			static JsonSchema const stateRootSchema = receiptSchema("stateRoot");
+			requireJsonFields(_receipt, "transactionReceipt",
+				_receipt.count("stateRoot") ? stateRootSchema : statusSchema);
 
             for (auto const& log : m_data.atKey("logs").getSubObjects())
                 m_logs.push_back(logs(log));
@@ -45,13 +33,30 @@ namespace test {
 		}
 
 		private:
+		// Post Byzantium receipts have `status` field instead of `stateRoot`
+		static JsonSchema receiptSchema(std::string const& _statusField)
+		{
+			return JsonSchema({
+					{"blockHash", {DataType::String} },
+					{"blockNumber", {DataType::Integer} },
+					{"contractAddress", {DataType::String} },
+					{"cumulativeGasUsed", {DataType::String} },
+					{"gasUsed", {DataType::String} },
+					{"logs", {DataType::Array} },
+					{"logsBloom", {DataType::String} },
+					{_statusField, {DataType::String} },
+					{"transactionHash", {DataType::String} },
+					{"transactionIndex", {DataType::Integer} }
+				});
+		}
+
 		class logs : public object
 		{
 			public:
 			logs(DataObject const& _logs):
 				object(_logs)
 			{
-				requireJsonFields(_logs, "transactionReceipt_logs", {
+				static JsonSchema const schema({
 						{"address", {DataType::String} },
 						{"blockHash", {DataType::String} },
 						{"blockNumber", {DataType::Integer} },
@@ -63,6 +68,7 @@ namespace test {
 						{"transactionIndex", {DataType::Integer} },
 						{"type", {DataType::String} }
 					});
+				requireJsonFields(_logs, "transactionReceipt_logs", schema);
 			}
 
 			void streamRLP(dev::RLPStream& _rlp) const
@@ -71,7 +77,7 @@ namespace test {
                 for (auto const& topic : m_data.atKey("topics").getSubObjects())
                     topics.push_back(dev::h256(topic.asString()));
 
-                _rlp.appendList(3) << dev::Address(m_data.atKey("address").asString()) << topics
+                _rlp.appendList(3) << m_data.atKey("address").asH160() << topics
                                    << dev::fromHex(m_data.atKey("data").asString());
             }
 		};
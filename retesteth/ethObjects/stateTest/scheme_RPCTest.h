@@ -12,7 +12,7 @@ public:
     scheme_RPCTestBase(DataObject const& _test) :
         object(_test)
     {
-        requireJsonFields(_test, "rpcTest " + _test.getKey(),
+        static JsonSchema const schema(
             {{"request_method", {{DataType::String}, jsonField::Required}},
              {"request_params", {{DataType::Array}, jsonField::Required}},
              {"expect_return", {{DataType::Object}, jsonField::Required}},
@@ -20,6 +20,7 @@ public:
              {"sealEngine", {{DataType::String}, jsonField::Optional}},
              {"pre", {{DataType::Object}, jsonField::Optional}}
                           });
+        requireJsonFields(_test, "rpcTest " + _test.getKey(), schema);
         if (_test.count("pre") || _test.count("sealEngine") || _test.count("genesis"))
         {
             if (!_test.count("pre") && !_test.count("sealEngine") && !_test.count("genesis"))
@@ -30,11 +31,11 @@ public:
             string sealEngine = _test.atKey("sealEngine").asString();
             scheme_env env(_test.atKey("genesis"));
             scheme_state pre(_test.atKey("pre"));
-            string network = "Frontier";
+            Fork const fork = networkFork("Frontier");
 
-            m_genesis = prepareGenesisParams(network, sealEngine);
+            m_genesis = prepareGenesisParams(fork, sealEngine);
             m_genesis["genesis"] = env.getDataForRPC();
-            m_genesis["accounts"] = pre.getDataForRPC(network);
+            m_genesis["accounts"] = pre.getDataForRPC(fork);
         }
     }
 
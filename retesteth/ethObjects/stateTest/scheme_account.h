@@ -22,12 +22,13 @@ public:
     scheme_account(DataObject const& _account):
         object(_account)
     {
-        requireJsonFields(_account, "account " + _account.getKey(), {
+        static JsonSchema const schema({
                               {"balance", {DataType::String} },
                               {"code", {DataType::String} },
                               {"nonce", {DataType::String} },
                               {"storage", {DataType::Object} }
                           });
+        requireJsonFields(_account, "account " + _account.getKey(), schema);
 
         validateStorage(m_data);
 
@@ -9,7 +9,7 @@ namespace test {
         scheme_env(DataObject const& _env):
                 object(_env)
         {
-            test::requireJsonFields(_env, _env.getKey(), {
+            static JsonSchema const schema({
                 {"currentCoinbase", {DataType::String} },
                 {"currentDifficulty", {DataType::String} },
                 {"currentGasLimit", {DataType::String} },
@@ -17,6 +17,7 @@ namespace test {
                 {"currentTimestamp", {DataType::String} },
                 {"previousHash", {DataType::String} },
             });
+            test::requireJsonFields(_env, _env.getKey(), schema);
 
             ETH_ERROR_REQUIRE_MESSAGE(dev::u256(_env.atKey("currentGasLimit").asString()) <=
                                           dev::u256("0x7fffffffffffffff"),
@@ -9,15 +9,17 @@ namespace  test {
         scheme_postSectionElement(DataObject const& _expect):
             object(_expect)
         {
-            requireJsonFields(_expect, "post", {
+            static JsonSchema const postSchema({
                 {"hash", {DataType::String} },
                 {"logs", {DataType::String} },
                 {"indexes", {DataType::Object} }
             });
-            requireJsonFields(_expect.atKey("indexes"), "indexes",
+            requireJsonFields(_expect, "post", postSchema);
+            static JsonSchema const indexesSchema(
                 {{"data", {DataType::Array, DataType::Integer}},
                     {"gas", {DataType::Array, DataType::Integer}},
                     {"value", {DataType::Array, DataType::Integer}}});
+            requireJsonFields(_expect.atKey("indexes"), "indexes", indexesSchema);
 
             parseJsonIntValueIntoSet(_expect.atKey("indexes").atKey("data"), m_dataIndexes);
             parseJsonIntValueIntoSet(_expect.atKey("indexes").atKey("gas"), m_gasIndexes);
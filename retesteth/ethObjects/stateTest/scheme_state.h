@@ -43,7 +43,7 @@ public:
     }
 
     // Insert precompiled account info into genesis
-    DataObject getDataForRPC(std::string const& _network) const;
+    DataObject getDataForRPC(Fork _fork) const;
 
 private:
     std::vector<scheme_account> m_accounts;
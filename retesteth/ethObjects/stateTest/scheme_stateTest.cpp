@@ -10,12 +10,23 @@ scheme_stateTestBase::scheme_stateTestBase(DataObject const& _test)
     m_transaction(_test.atKey("transaction"))
 {}
 
-DataObject scheme_stateTestBase::getGenesisForRPC(
+string const& scheme_stateTestBase::getGenesisForRPC(
     const string& _network, const string& _sealEngine) const
 {
-    DataObject genesis = prepareGenesisParams(_network, _sealEngine);
+    // Chain is reset with the same params for every transaction
+    string& genesis = m_genesisForRPC[std::make_pair(_network, _sealEngine)];
+    if (genesis.empty())
+        genesis = makeGenesisForRPC(_network, _sealEngine).asJson(0, false);
+    return genesis;
+}
+
+DataObject scheme_stateTestBase::makeGenesisForRPC(
+    const string& _network, const string& _sealEngine) const
+{
+    Fork const fork = networkFork(_network);
+    DataObject genesis = prepareGenesisParams(fork, _sealEngine);
     genesis["genesis"] = getEnv().getDataForRPC();
-    genesis["accounts"] = getPre().getDataForRPC(_network);
+    genesis["accounts"] = getPre().getDataForRPC(fork);
     return genesis;
 }
 
@@ -47,15 +58,16 @@ scheme_stateTest::scheme_stateTest(DataObject const& _test)
 
 scheme_stateTest::fieldChecker::fieldChecker(DataObject const& _test)
 {
-    requireJsonFields(_test, "stateTest " + _test.getKey(), {
+    static JsonSchema const schema({
         {"_info", {DataType::Object} },
         {"env", {DataType::Object} },
         {"pre", {DataType::Object} },
         {"transaction", {DataType::Object} },
         {"post", {DataType::Object} }
     });
+    requireJsonFields(_test, "stateTest " + _test.getKey(), schema);
 
-    requireJsonFields(_test.atKey("_info"), "stateTest " + _test.getKey() + " _info ",
+    static JsonSchema const infoSchema(
         {
             {"comment", {{DataType::String}, jsonField::Required}},
             {"source", {{DataType::String}, jsonField::Required}},
@@ -65,6 +77,8 @@ scheme_stateTest::fieldChecker::fieldChecker(DataObject const& _test)
             {"filling-rpc-server", {{DataType::String}, jsonField::Optional}},
             {"filling-tool-version", {{DataType::String}, jsonField::Optional}},
         });
+    requireJsonFields(
+        _test.atKey("_info"), "stateTest " + _test.getKey() + " _info ", infoSchema);
 
     // Check that `data` in compiled test is not just a string but a binary string
     ETH_ERROR_REQUIRE_MESSAGE(_test.atKey("transaction").count("data"),
@@ -81,24 +95,74 @@ scheme_stateTest::fieldChecker::fieldChecker(DataObject const& _test)
 
 scheme_stateTestFiller::fieldChecker::fieldChecker(DataObject const& _test)
 {
+	static JsonSchema const infoSchema({
+		{"_info", {DataType::Object} },
+		{"env", {DataType::Object} },
+		{"pre", {DataType::Object} },
+		{"transaction", {DataType::Object} },
+		{"expect", {DataType::Array} }
+	});
+	static JsonSchema const schema({
+		{"env", {DataType::Object} },
+		{"pre", {DataType::Object} },
+		{"transaction", {DataType::Object} },
+		{"expect", {DataType::Array} }
+	});
 	if (_test.count("_info"))
-		requireJsonFields(_test, "stateTestFiller " + _test.getKey(), {
-			{"_info", {DataType::Object} },
-			{"env", {DataType::Object} },
-			{"pre", {DataType::Object} },
-			{"transaction", {DataType::Object} },
-			{"expect", {DataType::Array} }
-		});
+		requireJsonFields(_test, "stateTestFiller " + _test.getKey(), infoSchema);
 	else
-		requireJsonFields(_test, "stateTestFiller " + _test.getKey(), {
-			{"env", {DataType::Object} },
-			{"pre", {DataType::Object} },
-			{"transaction", {DataType::Object} },
-			{"expect", {DataType::Array} }
-		});
+		requireJsonFields(_test, "stateTestFiller " + _test.getKey(), schema);
 }
 
 scheme_stateTestFiller::scheme_stateTestFiller(DataObject const& _test)
   : scheme_stateTestBase(_test), m_checker(_test), m_expectSection(_test.atKey("expect"))
 {
 }
+
+vector<boost::dynamic_bitset<>> scheme_stateTestFiller::getExpectTransactions(
+    string const& _network) const
+{
+    DataObject const& general = getGenTransaction().getData();
+    size_t const dataCount = general.atKey("data").getSubObjects().size();
+    size_t const gasCount = general.atKey("gasLimit").getSubObjects().size();
+    size_t const valueCount = general.atKey("value").getSubObjects().size();
+    vector<scheme_generalTransaction::transactionInfo> const& transactions = getTransactions();
+
+    vector<boost::dynamic_bitset<>> expectTransactions;
+    boost::dynamic_bitset<> covered(transactions.size());
+    for (auto const& expect : m_expectSection.getExpectSections())
+    {
+        expectTransactions.push_back(boost::dynamic_bitset<>(transactions.size()));
+        if (!expect.getNetworks().count(_network))
+            continue;
+
+        boost::dynamic_bitset<>& expected = expectTransactions.back();
+        scheme_expectSectionElement::IndexMasks const masks =
+            expect.getIndexMasks(dataCount, gasCount, valueCount);
+        for (size_t i = 0; i < transactions.size(); i++)
+        {
+            auto const& tr = transactions.at(i);
+            if (masks.data[tr.dataInd] && masks.gas[tr.gasInd] && masks.value[tr.valueInd])
+                expected.set(i);
+        }
+        if (expected.intersects(covered))
+        {
+            auto const& tr = transactions.at((expected & covered).find_first());
+            ETH_ERROR_MESSAGE("The test filler contain redundunt expect section: Network: " +
+                              _network + ", TrInfo: d: " + toString(tr.dataInd) + ", g: " +
+                              toString(tr.gasInd) + ", v: " + toString(tr.valueInd) +
+                              " is covered by several expect sections");
+        }
+        covered |= expected;
+    }
+
+    if (!covered.all())
+    {
+        auto const& tr = transactions.at((~covered).find_first());
+        ETH_TEST_MESSAGE("Network: " + _network + ", " + toString((~covered).count()) +
+                         " transactions are not covered by the expect section, first: d: " +
+                         toString(tr.dataInd) + ", g: " + toString(tr.gasInd) +
+                         ", v: " + toString(tr.valueInd));
+    }
+    return expectTransactions;
+}
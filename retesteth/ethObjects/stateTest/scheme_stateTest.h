@@ -38,6 +38,12 @@ namespace test {
         scheme_stateTestFiller(DataObject const& _test);
         scheme_expectSection const& getExpectSection() const { return m_expectSection; }
 
+        /// Transactions of every expect section on _network as bits over getTransactions(),
+        /// sections of the other networks have no bits set. Made in one pass that fails
+        /// if a transaction is covered by several expect sections of _network
+        std::vector<boost::dynamic_bitset<>> getExpectTransactions(
+            std::string const& _network) const;
+
     private:
         class fieldChecker
         {
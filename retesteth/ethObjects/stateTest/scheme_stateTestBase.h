@@ -9,6 +9,7 @@
 #include <dataObject/DataObject.h>
 #include <retesteth/Options.h>
 #include <retesteth/TestHelper.h>
+#include <map>
 
 using namespace  test;
 namespace testprivate {
@@ -22,10 +23,13 @@ namespace testprivate {
         std::vector<scheme_generalTransaction::transactionInfo> const& getTransactions() const { return m_transaction.getTransactions(); }
         std::vector<scheme_generalTransaction::transactionInfo>& getTransactionsUnsafe() { return m_transaction.getTransactionsUnsafe(); }
         void checkUnexecutedTransactions();
-        DataObject getGenesisForRPC(
+        /// test_setChainParams request json, made once for a network and seal engine
+        std::string const& getGenesisForRPC(
             const std::string& _network, const std::string& _sealEngine) const;
 
     private:
+        DataObject makeGenesisForRPC(
+            const std::string& _network, const std::string& _sealEngine) const;
         class fieldChecker
         {
             public:
@@ -35,5 +39,6 @@ namespace testprivate {
         scheme_env m_env;
         scheme_state m_pre;
         scheme_generalTransaction m_transaction;
+        mutable std::map<std::pair<std::string, std::string>, std::string> m_genesisForRPC;
     };
 }
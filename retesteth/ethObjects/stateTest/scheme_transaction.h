@@ -2,6 +2,7 @@
 #include "../object.h"
 #include "scheme_account.h"
 
+#include <retesteth/SignedTransactionCache.h>
 #include <retesteth/TestHelper.h>
 #include <libdevcore/RLP.h>
 #include <libdevcore/SHA3.h>
@@ -16,19 +17,21 @@ public:
     {
         if (_transaction.count("secretKey") > 0)
         {
-            test::requireJsonFields(_transaction, "transaction",
+            static JsonSchema const schema(
                 {{"data", {DataType::String}}, {"gasLimit", {DataType::String}},
                     {"gasPrice", {DataType::String}}, {"nonce", {DataType::String}},
                     {"secretKey", {DataType::String}}, {"to", {DataType::String}},
                     {"value", {DataType::String}}});
+            test::requireJsonFields(_transaction, "transaction", schema);
         }
         else
         {
-            test::requireJsonFields(_transaction, "transaction",
+            static JsonSchema const schema(
                 {{"data", {DataType::String}}, {"gasLimit", {DataType::String}},
                     {"gasPrice", {DataType::String}}, {"nonce", {DataType::String}},
                     {"v", {DataType::String}}, {"r", {DataType::String}}, {"s", {DataType::String}},
                     {"to", {DataType::String}}, {"value", {DataType::String}}});
+            test::requireJsonFields(_transaction, "transaction", schema);
         }
 
         m_data["version"] = "0x01";
@@ -41,11 +44,11 @@ public:
 
     std::string getSignedRLP() const
     {
-        u256 nonce = u256(m_data.atKey("nonce").asString());
-        u256 gasPrice = u256(m_data.atKey("gasPrice").asString());
-        u256 gasLimit = u256(m_data.atKey("gasLimit").asString());
-        Address trTo = Address(m_data.atKey("to").asString());
-        u256 value = u256(m_data.atKey("value").asString());
+        u256 const& nonce = m_data.atKey("nonce").asU256();
+        u256 const& gasPrice = m_data.atKey("gasPrice").asU256();
+        u256 const& gasLimit = m_data.atKey("gasLimit").asU256();
+        Address const trTo = m_data.atKey("to").asH160();
+        u256 const& value = m_data.atKey("value").asU256();
         bytes data = fromHex(m_data.atKey("data").asString());
 
         dev::RLPStream s;
@@ -61,59 +64,108 @@ public:
         s << data;
         h256 hash(dev::sha3(s.out()));
 
-        SignatureStruct sigStruct;
-        if (m_data.count("secretKey"))
-        {
-            Signature sig = dev::sign(dev::Secret(m_data.atKey("secretKey").asString()), hash);
-            sigStruct = *(SignatureStruct const*)&sig;
-            ETH_FAIL_REQUIRE_MESSAGE(sigStruct.isValid(),
-                TestOutputHelper::get().testName() + " Could not construct transaction signature!");
-        }
-        else
-        {
-            u256 vValue(m_data.atKey("v").asString());
-            sigStruct = SignatureStruct(h256(m_data.atKey("r").asString()),
-                h256(m_data.atKey("s").asString()), vValue.convert_to<byte>());
-        }
+        auto const sign = [&]() -> std::string {
+            SignatureStruct sigStruct;
+            if (m_data.count("secretKey"))
+            {
+                Signature sig = dev::sign(dev::Secret(m_data.atKey("secretKey").asString()), hash);
+                sigStruct = *(SignatureStruct const*)&sig;
+                ETH_FAIL_REQUIRE_MESSAGE(sigStruct.isValid(),
+                    TestOutputHelper::get().testName() +
+                        " Could not construct transaction signature!");
+            }
+            else
+            {
+                u256 const& vValue = m_data.atKey("v").asU256();
+                sigStruct = SignatureStruct(m_data.atKey("r").asH256(),
+                    m_data.atKey("s").asH256(), vValue.convert_to<byte>());
+            }
 
-        RLPStream sWithSignature;
-        sWithSignature.appendList(9);
-        sWithSignature << nonce;
-        sWithSignature << gasPrice;
-        sWithSignature << gasLimit;
-        if (m_data.atKey("to").asString().size() == 42)
-            sWithSignature << trTo;
-        else
-            sWithSignature << "";
-        sWithSignature << value;
-        sWithSignature << data;
-        byte v = m_data.count("secretKey") ? 27 + sigStruct.v : sigStruct.v;
-        sWithSignature << v;
-        sWithSignature << (u256)sigStruct.r;
-        sWithSignature << (u256)sigStruct.s;
-        return dev::toHexPrefixed(sWithSignature.out());
+            RLPStream sWithSignature;
+            sWithSignature.appendList(9);
+            sWithSignature << nonce;
+            sWithSignature << gasPrice;
+            sWithSignature << gasLimit;
+            if (m_data.atKey("to").asString().size() == 42)
+                sWithSignature << trTo;
+            else
+                sWithSignature << "";
+            sWithSignature << value;
+            sWithSignature << data;
+            byte v = m_data.count("secretKey") ? 27 + sigStruct.v : sigStruct.v;
+            sWithSignature << v;
+            sWithSignature << (u256)sigStruct.r;
+            sWithSignature << (u256)sigStruct.s;
+            return dev::toHexPrefixed(sWithSignature.out());
+        };
+        if (!m_data.count("secretKey"))
+            return sign();
+
+        // Same transaction fields and secret key give the same signed transaction
+        SHA3Stream key;
+        key.append(s.out());
+        key.append(dev::Secret(m_data.atKey("secretKey").asString()).ref());
+        return SignedTransactionCache::get().load(key.hash(), sign);
     }
     };
 
     class scheme_generalTransaction: public object
     {
         public:
+        /// Indexes of a transaction variant of the general transaction
+        /// The variant is made from the general transaction when it is executed
         struct transactionInfo
         {
-            transactionInfo(size_t _dataInd, size_t _gasInd, size_t _valueInd, DataObject const& _transaction) :
-                gasInd(_gasInd), dataInd(_dataInd), valueInd(_valueInd), executed(false), transaction(_transaction)
-                {}
+            transactionInfo(size_t _dataInd, size_t _gasInd, size_t _valueInd,
+                DataObject const& _generalTransaction)
+              : gasInd(_gasInd),
+                dataInd(_dataInd),
+                valueInd(_valueInd),
+                executed(false),
+                m_generalTransaction(_generalTransaction)
+            {}
             size_t gasInd;
             size_t dataInd;
             size_t valueInd;
             bool executed;
-            test::scheme_transaction transaction;
+
+            test::scheme_transaction const& transaction() const
+            {
+                if (!m_transaction)
+                    m_transaction = std::make_shared<scheme_transaction>(makeTransaction());
+                return *m_transaction;
+            }
+
+            private:
+            DataObject makeTransaction() const
+            {
+                DataObject const& general = m_generalTransaction;
+                DataObject singleTransaction(DataType::Object);
+                DataObject data(
+                    "data", general.atKey("data").getSubObjects().at(dataInd).asString());
+                DataObject gas(
+                    "gasLimit", general.atKey("gasLimit").getSubObjects().at(gasInd).asString());
+                DataObject value(
+                    "value", general.atKey("value").getSubObjects().at(valueInd).asString());
+
+                singleTransaction.addSubObject(data);
+                singleTransaction.addSubObject(gas);
+                singleTransaction.addSubObject(general.atKey("gasPrice"));
+                singleTransaction.addSubObject(general.atKey("nonce"));
+                singleTransaction.addSubObject(general.atKey("secretKey"));
+                singleTransaction.addSubObject(general.atKey("to"));
+                singleTransaction.addSubObject(value);
+                return singleTransaction;
+            }
+
+            DataObject m_generalTransaction;  // data of scheme_generalTransaction, not copied
+            mutable std::shared_ptr<scheme_transaction> m_transaction;
         };
 
         scheme_generalTransaction(DataObject const& _transaction):
             object(_transaction)
         {
-            test::requireJsonFields(_transaction, "transaction", {
+            static JsonSchema const schema({
                 {"data", {DataType::Array} },
                 {"gasLimit", {DataType::Array} },
                 {"gasPrice", {DataType::String} },
@@ -122,6 +174,7 @@ public:
                 {"to", {DataType::String} },
                 {"value", {DataType::Array} }
             });
+            test::requireJsonFields(_transaction, "transaction", schema);
             for (auto& element: m_data.getSubObjectsUnsafe())
             {
                 if (element.getKey() == "to" && !element.asString().empty())
@@ -155,25 +208,8 @@ public:
                 {
                     for (size_t valueInd = 0;
                          valueInd < m_data.atKey("value").getSubObjects().size(); valueInd++)
-                    {
-                        DataObject singleTransaction(DataType::Object);
-                        DataObject data(
-                            "data", m_data.atKey("data").getSubObjects().at(dataInd).asString());
-                        DataObject gas("gasLimit",
-                            m_data.atKey("gasLimit").getSubObjects().at(gasInd).asString());
-                        DataObject value(
-                            "value", m_data.atKey("value").getSubObjects().at(valueInd).asString());
-
-                        singleTransaction.addSubObject(data);
-                        singleTransaction.addSubObject(gas);
-                        singleTransaction.addSubObject(m_data.atKey("gasPrice"));
-                        singleTransaction.addSubObject(m_data.atKey("nonce"));
-                        singleTransaction.addSubObject(m_data.atKey("secretKey"));
-                        singleTransaction.addSubObject(m_data.atKey("to"));
-                        singleTransaction.addSubObject(value);
-                        transactionInfo info(dataInd, gasInd, valueInd, singleTransaction);
-                        m_transactions.push_back(info);
-                    }
+                        m_transactions.push_back(
+                            transactionInfo(dataInd, gasInd, valueInd, m_data));
                 }
             }
         }
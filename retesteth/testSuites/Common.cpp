@@ -3,6 +3,9 @@
 #include <dataObject/DataObject.h>
 #include <retesteth/Options.h>
 #include <retesteth/RPCSession.h>
+#include <boost/optional.hpp>
+#include <atomic>
+#include <future>
 using namespace std;
 namespace test
 {
@@ -61,41 +64,142 @@ void checkTestNameIsEqualToFileName(DataObject const& _input)
 }
 
 scheme_account remoteGetAccount(RPCSession& _session, string const& _account,
-    scheme_block const& _latestInfo, size_t& _totalSize)
+    string const& _blockNumber, size_t _txIndex, size_t& _totalSize,
+    RemoteAccountFields const& _fields)
 {
     DataObject accountObj;
     accountObj.setKey(_account);
-    accountObj["code"] = _session.eth_getCode(_account, _latestInfo.getNumber());
+    accountObj["code"] = "0x";
+    if (_fields.code)
+        accountObj["code"] = _session.eth_getCode(_account, _blockNumber);
     _totalSize += accountObj["code"].asString().size();
-    accountObj["nonce"] =
-        to_string(_session.eth_getTransactionCount(_account, _latestInfo.getNumber()));
-    accountObj["balance"] = _session.eth_getBalance(_account, _latestInfo.getNumber());
+    accountObj["nonce"] = "0";
+    if (_fields.nonce)
+        accountObj["nonce"] =
+            to_string(_session.eth_getTransactionCount(_account, _blockNumber));
+    accountObj["balance"] = "0";
+    if (_fields.balance)
+        accountObj["balance"] = _session.eth_getBalance(_account, _blockNumber);
 
     // Storage
-    const size_t cycles_max = 100;
-    const int cmaxRows = 100;
     DataObject storage(DataType::Object);
-    string beginHash = "0";
-    size_t cycles = cycles_max;
-    while (--cycles)
+    if (_fields.storage)
     {
-        DataObject debugStorageAt = _session.debug_storageRangeAt(_latestInfo.getNumber(),
-            _latestInfo.getTransactionCount(), _account, beginHash, cmaxRows);
-        auto const& subObjects = debugStorageAt["storage"].getSubObjects();
-        _totalSize += subObjects.size() * 64;
-        for (auto const& element : subObjects)
-            storage[element.atKey("key").asString()] = element.atKey("value").asString();
-        if (debugStorageAt.atKey("complete").asBool())
-            break;
-        if (subObjects.size() > 0)
-            beginHash = subObjects.at(subObjects.size() - 1).getKey();
+        const size_t cycles_max = 100;
+        const int cmaxRows = 100;
+        string beginHash = "0";
+        size_t cycles = cycles_max;
+        while (--cycles)
+        {
+            DataObject debugStorageAt = _session.debug_storageRangeAt(
+                _blockNumber, _txIndex, _account, beginHash, cmaxRows);
+            auto const& subObjects = debugStorageAt["storage"].getSubObjects();
+            _totalSize += subObjects.size() * 64;
+            for (auto const& element : subObjects)
+                storage[element.atKey("key").asString()] = element.atKey("value").asString();
+            if (debugStorageAt.atKey("complete").asBool())
+                break;
+            if (subObjects.size() > 0)
+                beginHash = subObjects.at(subObjects.size() - 1).getKey();
+        }
+        ETH_ERROR_REQUIRE_MESSAGE(cycles > 0, "Remote state has too many storage records! (" +
+                                                  to_string(cycles_max * cmaxRows) + ")");
     }
     accountObj["storage"] = storage;
-    ETH_ERROR_REQUIRE_MESSAGE(cycles > 0,
-        "Remote state has too many storage records! (" + to_string(cycles_max * cmaxRows) + ")");
     return scheme_account(accountObj);
 }
 
+vector<scheme_account> remoteGetAccounts(RPCSession& _session, vector<string> const& _accounts,
+    vector<RemoteAccountFields> const& _fields, scheme_block const& _latestInfo,
+    size_t& _totalSize, size_t _sizeLimit)
+{
+    vector<boost::optional<scheme_account>> accounts(_accounts.size());
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> totalSize(_totalSize);
+
+    // Worker threads only read these copies, block data is not shared with them
+    string const blockNumber = _latestInfo.getNumber();
+    size_t const txIndex = _latestInfo.getTransactionCount();
+    auto getAccounts = [&](RPCSession& _connection) {
+        try
+        {
+            for (size_t i = next++; i < _accounts.size(); i = next++)
+            {
+                if (_sizeLimit != 0 && totalSize > _sizeLimit)
+                    break;
+                size_t accountSize = 0;
+                accounts.at(i) = remoteGetAccount(
+                    _connection, _accounts.at(i), blockNumber, txIndex, accountSize, _fields.at(i));
+                totalSize += accountSize;
+            }
+        }
+        catch (...)
+        {
+            next = _accounts.size();  // stop the other connections
+            throw;
+        }
+    };
+
+    // Errors of a worker are reported in the name of the test that asks for the accounts
+    TestOutputHelper const& caller = TestOutputHelper::get();
+    boost::filesystem::path const testFile = caller.testFile();
+    string const testName = caller.testName();
+    string const testInfo = caller.testInfo();
+    auto getAccountsOnWorker = [&](RPCSession& _connection) {
+        TestOutputHelper& helper = TestOutputHelper::get();
+        helper.setCurrentTestFile(testFile);
+        helper.setCurrentTestName(testName);
+        helper.setCurrentTestInfo(testInfo);
+        getAccounts(_connection);
+    };
+
+    // The test thread asks over its own session, the other connections on their workers
+    size_t const connectionCount =
+        std::max<size_t>(1, std::min(Options::get().rpcConnections, _accounts.size()));
+    vector<RPCSession*> const connections = _session.connections(connectionCount);
+    vector<std::future<void>> workers;
+    for (size_t i = 1; i < connections.size(); i++)
+    {
+        RPCSession* connection = connections.at(i);
+        workers.push_back(connection->runOnWorker(
+            [&getAccountsOnWorker, connection]() { getAccountsOnWorker(*connection); }));
+    }
+    std::exception_ptr error;
+    try
+    {
+        getAccounts(*connections.at(0));
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    // All workers are waited for, they use the locals of this function
+    for (auto& worker : workers)
+    {
+        try
+        {
+            worker.get();
+        }
+        catch (...)
+        {
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+    if (error)
+        std::rethrow_exception(error);
+
+    _totalSize = totalSize;
+    vector<scheme_account> result;
+    for (auto const& account : accounts)
+    {
+        if (!account.is_initialized())
+            break;
+        result.push_back(account.get());
+    }
+    return result;
+}
+
 scheme_state getRemoteState(RPCSession& _session, scheme_block const& _latestInfo)
 {
     const int c_accountLimitBeforeHash = 20;
@@ -124,17 +228,19 @@ scheme_state getRemoteState(RPCSession& _session, scheme_block const& _latestInf
 
     if (!isHugeState || Options::get().fullstate)
     {
+        vector<string> accounts;
+        for (auto const& acc : accountList.getSubObjects())
+            accounts.push_back(acc.getKey());
+        size_t const sizeLimit = Options::get().fullstate ? 0 : 1024000;  // > 1MB
         size_t stateTotalSize = 0;
-        for (auto acc : accountList.getSubObjects())
+        vector<scheme_account> const remoteAccounts = remoteGetAccounts(_session, accounts,
+            vector<RemoteAccountFields>(accounts.size()), _latestInfo, stateTotalSize, sizeLimit);
+        if (sizeLimit != 0 && stateTotalSize > sizeLimit)
+            isHugeState = true;
+        else
         {
-            scheme_account accountScheme =
-                remoteGetAccount(_session, acc.getKey(), _latestInfo, stateTotalSize);
-            if (stateTotalSize > 1024000 && !Options::get().fullstate)  // > 1MB
-            {
-                isHugeState = true;
-                break;
-            }
-            accountsObj.addSubObject(accountScheme.getData());
+            for (auto const& accountScheme : remoteAccounts)
+                accountsObj.addSubObject(accountScheme.getData());
         }
     }
 
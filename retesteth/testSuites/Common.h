@@ -50,9 +50,28 @@ void compareStates(
 void compareStates(scheme_expectState const& _stateExpect, scheme_state const& _statePost);
 string CompareResultToString(CompareResult res);
 
-// Get account from remote state. inline function
+// Fields of an account to get from remote state
+struct RemoteAccountFields
+{
+    bool balance = true;
+    bool nonce = true;
+    bool code = true;
+    bool storage = true;
+};
+
+// Get account from remote state at block _blockNumber after _txIndex transactions
+// The fields that are not requested are not asked from the client and left zero
 scheme_account remoteGetAccount(RPCSession& _session, string const& _account,
-    scheme_block const& _latestInfo, size_t& _totalSize);
+    string const& _blockNumber, size_t _txIndex, size_t& _totalSize,
+    RemoteAccountFields const& _fields = RemoteAccountFields());
+
+// Get accounts from remote state in the order of _accounts, _fields of every account
+// Up to Options::rpcConnections accounts are asked at once over separate connections,
+// each extra connection on its worker thread (see RPCSession::runOnWorker)
+// Stops when the size of the accounts reaches _sizeLimit (if not 0), then the list is incomplete
+std::vector<scheme_account> remoteGetAccounts(RPCSession& _session,
+    std::vector<string> const& _accounts, std::vector<RemoteAccountFields> const& _fields,
+    scheme_block const& _latestInfo, size_t& _totalSize, size_t _sizeLimit = 0);
 
 // Get list of account from remote client
 DataObject getRemoteAccountList(RPCSession& _session, scheme_block const& _latestInfo);
@@ -41,13 +41,13 @@ CompareResult compareAccounts(
 
     if (_expectAccount.hasBalance())
     {
-        u256 inStateB = u256(_inState.getData().atKey("balance").asString());
+        u256 inStateB = _inState.getData().atKey("balance").asU256();
         checkMessage(_expectAccount.getData().atKey("balance").asString() ==
                          _inState.getData().atKey("balance").asString(),
             CompareResult::IncorrectBalance,
             TestOutputHelper::get().testName() + " Check State: '" + _expectAccount.address() +
                 "': incorrect balance " + toString(inStateB) + ", expected " +
-                toString(u256(_expectAccount.getData().atKey("balance").asString())) + " (" +
+                toString(_expectAccount.getData().atKey("balance").asU256()) + " (" +
                 _expectAccount.getData().atKey("balance").asString() +
                 " != " + _inState.getData().atKey("balance").asString() + ")");
     }
@@ -118,6 +118,9 @@ void compareStates(
 {
     CompareResult result = CompareResult::Success;
     DataObject accountList = getRemoteAccountList(_session, _latestInfo);
+    vector<scheme_expectAccount const*> expectAccounts;
+    vector<string> addresses;
+    vector<RemoteAccountFields> fields;
     for (auto const& a : _stateExpect.getAccounts())
     {
         bool hasAccount = accountList.count(a.address());
@@ -130,10 +133,25 @@ void compareStates(
         if (!hasAccount)
             continue;
 
-        // Compare account in postState with expect section account
-        size_t totalSize = 0;
+        // Ask the client only for the fields that are checked
+        RemoteAccountFields accountFields;
+        accountFields.balance = a.hasBalance();
+        accountFields.nonce = a.hasNonce();
+        accountFields.code = a.hasCode();
+        accountFields.storage = a.hasStorage();
+        expectAccounts.push_back(&a);
+        addresses.push_back(a.address());
+        fields.push_back(accountFields);
+    }
+
+    // Compare account in postState with expect section account
+    size_t totalSize = 0;
+    vector<scheme_account> const remoteAccounts =
+        remoteGetAccounts(_session, addresses, fields, _latestInfo, totalSize);
+    for (size_t i = 0; i < remoteAccounts.size(); i++)
+    {
         CompareResult accountCompareResult =
-            compareAccounts(remoteGetAccount(_session, a.address(), _latestInfo, totalSize), a);
+            compareAccounts(remoteAccounts.at(i), *expectAccounts.at(i));
         if (accountCompareResult != CompareResult::Success)
             result = accountCompareResult;
     }
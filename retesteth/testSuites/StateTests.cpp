@@ -66,83 +66,76 @@ DataObject FillTestAsBlockchain(DataObject const& _testFile)
     // run transactions on all networks that we need
     for (auto const& net : test.getExpectSection().getAllNetworksFromExpectSection())
     {
+        Fork const fork = toFork(net);
         // run transactions for defined expect sections only
-        for (auto const& expect : test.getExpectSection().getExpectSections())
+        vector<boost::dynamic_bitset<>> const expectTransactions = test.getExpectTransactions(net);
+        for (size_t expectInd = 0; expectInd < expectTransactions.size(); expectInd++)
         {
-            // if expect section for this networks
-            if (expect.getNetworks().count(net))
+            auto const& expect = test.getExpectSection().getExpectSections().at(expectInd);
+            boost::dynamic_bitset<> const& transactions = expectTransactions.at(expectInd);
+            for (size_t trInd = transactions.find_first(); trInd != boost::dynamic_bitset<>::npos;
+                 trInd = transactions.find_next(trInd))
             {
-                for (auto& tr : test.getTransactionsUnsafe())
-                {
-                    if (!OptionsAllowTransaction(tr))
-                        continue;
-
-                    // if expect section is for this transaction
-                    if (!expect.checkIndexes(tr.dataInd, tr.gasInd, tr.valueInd))
-                        continue;
-
-                    TestOutputHelper::get().setCurrentTestInfo(
-                        "Network: " + net + ", TrInfo: d: " + toString(tr.dataInd) +
-                        ", g: " + toString(tr.gasInd) + ", v: " + toString(tr.valueInd) +
-                        ", Test: " + TestOutputHelper::get().testName());
-
-                    // State Tests does not have mining rewards
-                    scheme_expectSectionElement mexpect = expect;
-                    mexpect.correctMiningReward(net, test.getEnv().getCoinbase());
-
-                    string sEngine = "NoProof";
-                    session.test_setChainParams(test.getGenesisForRPC(net, sEngine).asJson());
-                    u256 a(test.getEnv().getData().atKey("currentTimestamp").asString());
-                    session.test_modifyTimestamp(a.convert_to<size_t>());
-                    string signedTransactionRLP = tr.transaction.getSignedRLP();
-                    string trHash = session.eth_sendRawTransaction(signedTransactionRLP);
-
-                    if (!session.getLastRPCError().empty())
-                        ETH_ERROR_MESSAGE(session.getLastRPCError());
-                    if (!isHash<h256>(trHash))
-                        ETH_ERROR_MESSAGE("eth_sendRawTransaction return invalid hash: '" + trHash +
-                                          "' " + TestOutputHelper::get().testInfo());
-
-                    string latestBlockNumber = session.test_mineBlocks(1);
-                    tr.executed = true;
+                auto& tr = test.getTransactionsUnsafe().at(trInd);
+                if (!OptionsAllowTransaction(tr))
+                    continue;
 
-                    scheme_block remoteBlock =
-                        session.eth_getBlockByNumber(latestBlockNumber, true);
-                    scheme_state remoteState = getRemoteState(session, remoteBlock);
-                    if (remoteState.isHash())
-                        compareStates(mexpect.getExpectState(), session, remoteBlock);
-                    else
-                        compareStates(mexpect.getExpectState(), remoteState);
-
-                    DataObject aBlockchainTest;
-                    if (test.getData().count("_info"))
-                        aBlockchainTest["_info"] = test.getData().atKey("_info");
-                    aBlockchainTest["genesisBlockHeader"] = test.getEnv().getDataForRPC();
-                    aBlockchainTest["pre"] = test.getPre().getData();
-                    aBlockchainTest["postState"] = remoteState.getData();
-                    aBlockchainTest["network"] = net;
-                    aBlockchainTest["sealEngine"] = sEngine;
-                    aBlockchainTest["lastblockhash"] = remoteBlock.getBlockHash();
-
-                    test::scheme_block genesisBlock = session.eth_getBlockByNumber("0", true);
-                    aBlockchainTest["genesisRLP"] = genesisBlock.getBlockRLP();
-
-                    DataObject block;
-                    block["rlp"] = remoteBlock.getBlockRLP();
-                    block["blockHeader"] = remoteBlock.getBlockHeader();
-                    aBlockchainTest["blocks"].addArrayObject(block);
-
-                    string dataPostfix = "_d" + toString(tr.dataInd) + "g" + toString(tr.gasInd) +
-                                         "v" + toString(tr.valueInd);
-                    dataPostfix += "_" + net;
-
-                    if (filledTest.count(_testFile.getKey() + dataPostfix))
-                        ETH_ERROR_MESSAGE("The test filler contain redundunt expect section: " +
-                                          TestOutputHelper::get().testInfo());
-
-                    filledTest[_testFile.getKey() + dataPostfix] = aBlockchainTest;
-                    session.test_rewindToBlock(0);
-                }
+                TestOutputHelper::get().setCurrentTestInfo(
+                    "Network: " + net + ", TrInfo: d: " + toString(tr.dataInd) +
+                    ", g: " + toString(tr.gasInd) + ", v: " + toString(tr.valueInd) +
+                    ", Test: " + TestOutputHelper::get().testName());
+
+                // State Tests does not have mining rewards
+                scheme_expectSectionElement mexpect = expect;
+                mexpect.correctMiningReward(fork, test.getEnv().getCoinbase());
+
+                string sEngine = "NoProof";
+                session.test_setChainParams(test.getGenesisForRPC(net, sEngine));
+                u256 a(test.getEnv().getData().atKey("currentTimestamp").asString());
+                session.test_modifyTimestamp(a.convert_to<size_t>());
+                string signedTransactionRLP = tr.transaction().getSignedRLP();
+                string trHash = session.eth_sendRawTransaction(signedTransactionRLP);
+
+                if (!session.getLastRPCError().empty())
+                    ETH_ERROR_MESSAGE(session.getLastRPCError());
+                if (!isHash<h256>(trHash))
+                    ETH_ERROR_MESSAGE("eth_sendRawTransaction return invalid hash: '" + trHash +
+                                      "' " + TestOutputHelper::get().testInfo());
+
+                string latestBlockNumber = session.test_mineBlocks(1);
+                tr.executed = true;
+
+                scheme_block remoteBlock = session.eth_getBlockByNumber(latestBlockNumber, true);
+                scheme_state remoteState = getRemoteState(session, remoteBlock);
+                if (remoteState.isHash())
+                    compareStates(mexpect.getExpectState(), session, remoteBlock);
+                else
+                    compareStates(mexpect.getExpectState(), remoteState);
+
+                DataObject aBlockchainTest;
+                if (test.getData().count("_info"))
+                    aBlockchainTest["_info"] = test.getData().atKey("_info");
+                aBlockchainTest["genesisBlockHeader"] = test.getEnv().getDataForRPC();
+                aBlockchainTest["pre"] = test.getPre().getData();
+                aBlockchainTest["postState"] = remoteState.getData();
+                aBlockchainTest["network"] = net;
+                aBlockchainTest["sealEngine"] = sEngine;
+                aBlockchainTest["lastblockhash"] = remoteBlock.getBlockHash();
+
+                test::scheme_block genesisBlock = session.eth_getBlockByNumber("0", true);
+                aBlockchainTest["genesisRLP"] = genesisBlock.getBlockRLP();
+
+                DataObject block;
+                block["rlp"] = remoteBlock.getBlockRLP();
+                block["blockHeader"] = remoteBlock.getBlockHeader();
+                aBlockchainTest["blocks"].addArrayObject(block);
+
+                string dataPostfix = "_d" + toString(tr.dataInd) + "g" + toString(tr.gasInd) +
+                                     "v" + toString(tr.valueInd);
+                dataPostfix += "_" + net;
+
+                filledTest[_testFile.getKey() + dataPostfix] = aBlockchainTest;
+                session.test_rewindToBlock(0);
             }
         }
         test.checkUnexecutedTransactions();
@@ -169,54 +162,51 @@ DataObject FillTest(DataObject const& _testFile)
     {
         DataObject forkResults;
         forkResults.setKey(net);
-        session.test_setChainParams(test.getGenesisForRPC(net, "NoReward").asJson());
+        session.test_setChainParams(test.getGenesisForRPC(net, "NoReward"));
 
         // run transactions for defined expect sections only
-        for (auto const& expect : test.getExpectSection().getExpectSections())
+        vector<boost::dynamic_bitset<>> const expectTransactions = test.getExpectTransactions(net);
+        for (size_t expectInd = 0; expectInd < expectTransactions.size(); expectInd++)
         {
-            // if expect section for this networks
-            if (expect.getNetworks().count(net))
+            auto const& expect = test.getExpectSection().getExpectSections().at(expectInd);
+            boost::dynamic_bitset<> const& transactions = expectTransactions.at(expectInd);
+            for (size_t trInd = transactions.find_first(); trInd != boost::dynamic_bitset<>::npos;
+                 trInd = transactions.find_next(trInd))
             {
-                for (auto& tr : test.getTransactionsUnsafe())
-                {
-                    if (!OptionsAllowTransaction(tr))
-                        continue;
-
-                    // if expect section is for this transaction
-                    if (!expect.checkIndexes(tr.dataInd, tr.gasInd, tr.valueInd))
-                        continue;
+                auto& tr = test.getTransactionsUnsafe().at(trInd);
+                if (!OptionsAllowTransaction(tr))
+                    continue;
 
-                    TestOutputHelper::get().setCurrentTestInfo(
-                        "Network: " + net + ", TrInfo: d: " + toString(tr.dataInd) +
-                        ", g: " + toString(tr.gasInd) + ", v: " + toString(tr.valueInd) +
-                        ", Test: " + TestOutputHelper::get().testName());
+                TestOutputHelper::get().setCurrentTestInfo(
+                    "Network: " + net + ", TrInfo: d: " + toString(tr.dataInd) +
+                    ", g: " + toString(tr.gasInd) + ", v: " + toString(tr.valueInd) +
+                    ", Test: " + TestOutputHelper::get().testName());
 
-                    u256 a(test.getEnv().getData().atKey("currentTimestamp").asString());
-                    session.test_modifyTimestamp(a.convert_to<size_t>());
-                    string trHash = session.eth_sendRawTransaction(tr.transaction.getSignedRLP());
-                    string latestBlockNumber = session.test_mineBlocks(1);
-                    tr.executed = true;
+                u256 a(test.getEnv().getData().atKey("currentTimestamp").asString());
+                session.test_modifyTimestamp(a.convert_to<size_t>());
+                string trHash = session.eth_sendRawTransaction(tr.transaction().getSignedRLP());
+                string latestBlockNumber = session.test_mineBlocks(1);
+                tr.executed = true;
 
-                    scheme_block blockInfo = session.eth_getBlockByNumber(latestBlockNumber, false);
-                    compareStates(expect.getExpectState(), session, blockInfo);
+                scheme_block blockInfo = session.eth_getBlockByNumber(latestBlockNumber, false);
+                compareStates(expect.getExpectState(), session, blockInfo);
 
-                    DataObject indexes;
-                    DataObject transactionResults;
-                    indexes["data"] = tr.dataInd;
-                    indexes["gas"] = tr.gasInd;
-                    indexes["value"] = tr.valueInd;
+                DataObject indexes;
+                DataObject transactionResults;
+                indexes["data"] = tr.dataInd;
+                indexes["gas"] = tr.gasInd;
+                indexes["value"] = tr.valueInd;
 
-                    transactionResults["indexes"] = indexes;
-                    transactionResults["hash"] = blockInfo.getStateHash();
+                transactionResults["indexes"] = indexes;
+                transactionResults["hash"] = blockInfo.getStateHash();
 
-                    // Fill up the loghash (optional)
-                    string logHash = session.test_getLogHash(trHash);
-                    if (!logHash.empty())
-                        transactionResults["logs"] = logHash;
+                // Fill up the loghash (optional)
+                string logHash = session.test_getLogHash(trHash);
+                if (!logHash.empty())
+                    transactionResults["logs"] = logHash;
 
-                    forkResults.addArrayObject(transactionResults);
-                    session.test_rewindToBlock(0);
-                }
+                forkResults.addArrayObject(transactionResults);
+                session.test_rewindToBlock(0);
             }
         }
         test.checkUnexecutedTransactions();
@@ -238,7 +228,7 @@ void RunTest(DataObject const& _testFile)
         if (!Options::get().singleTestNet.empty() && Options::get().singleTestNet != network)
             continue;
 
-        session.test_setChainParams(test.getGenesisForRPC(network, "NoReward").asJson());
+        session.test_setChainParams(test.getGenesisForRPC(network, "NoReward"));
 
         // read all results for a specific fork
         for (auto const& result: post.second)
@@ -258,7 +248,7 @@ void RunTest(DataObject const& _testFile)
                     TestOutputHelper::get().setCurrentTestInfo(testInfo);
                     u256 a(test.getEnv().getData().atKey("currentTimestamp").asString());
                     session.test_modifyTimestamp(a.convert_to<size_t>());
-                    string trHash = session.eth_sendRawTransaction(tr.transaction.getSignedRLP());
+                    string trHash = session.eth_sendRawTransaction(tr.transaction().getSignedRLP());
                     string latestBlockNumber = session.test_mineBlocks(1);
                     tr.executed = true;
                     blockMined = true;
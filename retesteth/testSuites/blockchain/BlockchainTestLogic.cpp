@@ -18,7 +18,7 @@ void FillTest(scheme_blockchainTestFiller const& _testObject, string const& _net
 
     RPCSession& session = RPCSession::instance(TestOutputHelper::getThreadID());
     DataObject genesisObject = _testObject.getGenesisForRPC(_network);
-    session.test_setChainParams(genesisObject.asJson());
+    session.test_setChainParams(genesisObject);
 
     test::scheme_block latestBlock = session.eth_getBlockByNumber("0", false);
     _testOut["genesisBlockHeader"] = latestBlock.getBlockHeader();
@@ -73,7 +73,7 @@ void RunTest(DataObject const& _testObject, TestSuite::TestSuiteOptions const& _
     string testInfo = TestOutputHelper::get().testName() + ", fork: " + inputTest.getNetwork();
     TestOutputHelper::get().setCurrentTestInfo(testInfo);
 
-    session.test_setChainParams(inputTest.getGenesisForRPC(inputTest.getNetwork()).asJson());
+    session.test_setChainParams(inputTest.getGenesisForRPC(inputTest.getNetwork()));
 
     // for all blocks
     for (auto const& brlp : inputTest.getBlockRlps())
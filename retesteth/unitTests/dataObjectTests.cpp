@@ -18,8 +18,11 @@
  * Unit tests for TestHelper functions.
  */
 
+#include <dataObject/ConvertBinary.h>
 #include <dataObject/ConvertFile.h>
+#include <dataObject/ConvertYaml.h>
 #include <dataObject/DataObject.h>
+#include <dataObject/JsonOutput.h>
 #include <retesteth/TestOutputHelper.h>
 #include <boost/test/unit_test.hpp>
 
@@ -28,6 +31,36 @@ using namespace dev;
 using namespace test;
 using namespace dataobject;
 
+namespace
+{
+// Yaml conversion through YAML::Node, the reference for the event based reader
+DataObject convertYamlNode(YAML::Node const& _node)
+{
+    if (_node.IsNull())
+        return DataObject(DataType::Null);
+    if (_node.IsScalar())
+    {
+        if (_node.Tag() == "tag:yaml.org,2002:int")
+            return DataObject(_node.as<int>());
+        return DataObject(_node.as<string>());
+    }
+
+    DataObject result(_node.IsMap() ? DataType::Object : DataType::Array);
+    result.setAutosort(true);
+    if (_node.IsMap())
+    {
+        for (auto const& i : _node)
+            result.addSubObject(i.first.as<string>(), convertYamlNode(i.second));
+    }
+    else
+    {
+        for (size_t i = 0; i < _node.size(); i++)
+            result.addArrayObject(convertYamlNode(_node[i]));
+    }
+    return result;
+}
+}  // namespace
+
 BOOST_FIXTURE_TEST_SUITE(DataObjectTestSuite, TestOutputHelperFixture)
 
 BOOST_AUTO_TEST_CASE(dataobject_invalidJson1)
@@ -452,6 +485,210 @@ BOOST_AUTO_TEST_CASE(dataobject_readJson15)
     BOOST_CHECK(dObj.asJson(0, false) == res);
 }
 
+BOOST_AUTO_TEST_CASE(dataobject_readJson16)
+{
+    // strings and numbers crossing 64 byte blocks of the structural index
+    string const longStr(70, 'a');
+    string data = "{\"b\":[[false,1],[]],\"a\":\"" + longStr + "\",\"c\":{\"k\":null,\"j\":-1234567}";
+    data += string(61, ' ') + ",\"a2\":[" + string(60, ' ') + "12345678,true]}";
+    DataObject dObj = ConvertJsoncppStringToData(data, string(), true);
+    string const res = "{\"a\":\"" + longStr +
+                       "\",\"a2\":[12345678,true],\"b\":[[false,1],[]],\"c\":{\"j\":-1234567,\"k\":{}}}";
+    BOOST_CHECK(dObj.asJson(0, false) == res);
+}
+
+
+BOOST_AUTO_TEST_CASE(dataobject_readJsonView)
+{
+    string const data = R"({"b":"0x1122334455667788990011223344556677889900","a":["text", 1]})";
+    ReadOnlyView const source(data);
+    DataObject dObj = ConvertJsoncppStringToData(source, string(), true);
+    BOOST_CHECK(dObj.asJson(0, false) == ConvertJsoncppStringToData(data, string(), true).asJson(0, false));
+    BOOST_CHECK(dObj.count("b"));
+
+    DataObject copy = dObj.atKey("b");
+    dObj["b"] = "changed";
+    BOOST_CHECK(dObj.atKey("b").asString() == "changed");
+    BOOST_CHECK(copy.getKey() == "b");
+    BOOST_CHECK(copy.asString() == "0x1122334455667788990011223344556677889900");
+    BOOST_CHECK(dObj.atKey("a").at(0).asString() == "text");
+}
+
+BOOST_AUTO_TEST_CASE(dataobject_readJsonMappedFile)
+{
+    boost::filesystem::path const file =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    writeFile(file, asBytes(R"({"key":["text",-120],"empty":""})"));
+    DataObject dObj = ConvertJsoncppStringToData(mapFile(file));
+    boost::filesystem::remove(file);  // mapping is kept by the strings of dObj
+    BOOST_CHECK(dObj.atKey("key").at(0).asString() == "text");
+    BOOST_CHECK(dObj.atKey("key").at(1).asInt() == -120);
+    BOOST_CHECK(dObj.asJson(0, false) == R"({"key":["text",-120],"empty":""})");
+    BOOST_CHECK(mapFile(file).empty());
+}
+
+BOOST_AUTO_TEST_CASE(dataobject_readJsonSkipKeys)
+{
+    string const data = R"({
+        "test1" : {
+            "//comment" : { "a" : [ 1, { "//" : "x" } ] },
+            "env" : { "number" : 1, "//number" : "one" },
+            "post" : [ { "//" : "element", "hash" : "0x01" }, "x" ],
+            "pre" : { "code" : "{ [[0]] 1 }" }
+        },
+        "test2" : { "pre" : [] },
+        "//test3" : 1
+    })";
+    ReadOnlyView const source(data);
+    JsonParseOptions options;
+    options.autosort = true;
+    options.skip.skipPrefix("//");
+    BOOST_CHECK(ConvertJsoncppStringToData(source, options).asJson(0, false) ==
+                R"({"test1":{"env":{"number":1},"post":[{"hash":"0x01"},"x"],)"
+                R"("pre":{"code":"{ [[0]] 1 }"}},"test2":{"pre":[]}})");
+
+    // Removing the keys from the whole data gives the same, fillers are hashed before it
+    options.skip = KeyFilter();
+    DataObject full = ConvertJsoncppStringToData(source, options);
+    full.removeFilteredKeys(KeyFilter().skipPrefix("//"));
+    BOOST_CHECK(full.asJson(0, false) ==
+                R"({"test1":{"env":{"number":1},"post":[{"hash":"0x01"},"x"],)"
+                R"("pre":{"code":"{ [[0]] 1 }"}},"test2":{"pre":[]}})");
+
+    options.skip.skipPrefix("//").skipKey("pre").includeTopLevel("test1");
+    options.stopKeys.push_back("env");
+    BOOST_CHECK(ConvertJsoncppStringToData(source, options).asJson(0, false) ==
+                R"({"test1":{"env":{"number":1}}})");
+
+    string const yaml = "test1:\n  //comment: 1\n  pre:\n    - a: 1\n      //b: 2\n";
+    BOOST_CHECK(ConvertYamlToData(ReadOnlyView(yaml), KeyFilter().skipPrefix("//"))
+                    .asJson(0, false) == R"({"test1":{"pre":[{"a":"1"}]}})");
+}
+
+BOOST_AUTO_TEST_CASE(dataobject_readJsonLegacyValues)
+{
+    // Json is read to the output of the previous parser, filler hashes are made from it
+    // Outputs of these inputs are taken from the previous parser (autosort, input, output)
+    struct LegacyCase
+    {
+        bool autosort;
+        string input;
+        string output;
+    };
+    std::vector<LegacyCase> const cases = {
+        {false, R"({"a" : [ 1, false ]})", R"({"a":[1]})"},
+        {false, "{\"t0\": [true, {}, false]}\n", R"({"t0":[true,{}]})"},
+        {false, R"({"a" : 1 "b" : 2})", R"({"a":1,"b":2})"},
+        {false, "{\"t0\": {}, \"t1\": 714, \"t2\": [] \"t3\": {}}\n",
+            R"({"t0":{},"t1":714,"t2":[],"t3":{}})"},
+        {false, R"({"a":[1,],"b":1,})", R"({"a":[1],"b":1})"},
+        {false, R"({"t0": ["Bb-ed", 1e5, "dAB_c1"], "t1": -443, "t2": []})",
+            R"({"t0":["Bb-ed",1,5,"dAB_c1"],"t1":-443,"t2":[]})"},
+        {false, R"({"t0": [-2.25]})", R"({"t0":[-2,25]})"},
+        {false, "{\"t0\": [{\"k1-_0\": null}, nulltrue]}\n", R"({"t0":[{"k1-_0":{}},{},true]})"},
+        {false, R"({"t0": true, "t1": {"k0": [-x], "kd1A0A1": false}})",
+            R"({"t0":true,"t1":{"k0":[],"kd1A0A1":{}}})"},
+        // the '}' after an unread value closes the member and the object takes the members after it
+        {false, R"({"t0": {}, "t1": {"keB0": fals}, "t2": [1e5, true], "t3": []})",
+            R"({"t0":{},"t1":{"keB0":{},"t2":[1,5,true],"t3":[]}})"},
+        {true,
+            R"({"t0": {"kBAea0": {"kfbd20": {"kA-_32_0": [-2.25], "kA1": false}}, "kf1": ""}, "t1": {}, "t2": "c"})",
+            R"({"t0":{"kBAea0":{"kf1":"","kfbd20":{"kA-_32_0":[-2,25],"kA1":{}}},"t1":{},"t2":"c"}})"},
+        {false, R"({"t0": false "t1": 571})", R"({"t0":{"t1":571}})"},
+        {false, R"({"a":[{"b":false},null,{"c":1}],"d":2})", R"({"a":[{},{"c":1}],"d":2})"},
+        // a null member takes the value shifted onto it when the members are sorted
+        {true, R"({"d":{},"f":null,"a":[1],"c":"x"})", R"({"a":[1],"c":"x","f":{},"f":{}})"},
+        {true, R"({"b":{"y":null,"x":2,"w":false},"a":1})", R"({"b":{"a":1,"w":{},"y":2,"y":{}}})"},
+        {true, R"({"c":{"z":1,"y":null,"x":2,"w":3},"a":[{"k":null,"j":1,"i":2}]})",
+            R"({"a":[{"i":2,"j":1,"k":{}}],"c":{"w":3,"y":2,"y":{},"z":1}})"}};
+    for (auto const& test : cases)
+    {
+        ReadOnlyView const source(test.input);
+        DataObject const copied = ConvertJsoncppStringToData(test.input, "", test.autosort);
+        DataObject const viewed = ConvertJsoncppStringToData(source, "", test.autosort);
+        DataObject const lazy = LazyJsonDocument(source, test.autosort).getMembers();
+        BOOST_CHECK_MESSAGE(copied.asJson(0, false) == test.output, test.input);
+        BOOST_CHECK_MESSAGE(viewed.asJson(0, false) == test.output, test.input);
+        BOOST_CHECK_MESSAGE(lazy.asJson(0, false) == test.output, test.input);
+    }
+
+    string const data = R"({"test1" : { "a" : [ 1, false ], "//" : 1 }, "test2" : {}})";
+    ReadOnlyView const source(data);
+    JsonParseOptions options;
+    options.autosort = true;
+    options.skip.skipPrefix("//");
+    BOOST_CHECK(ConvertJsoncppStringToData(source, options).asJson(0, false) ==
+                R"({"test1":{"a":[1]},"test2":{}})");
+    LazyJsonDocument const document(source);
+    BOOST_CHECK(document.getKeys() == std::vector<string>({"test1", "test2"}));
+    BOOST_CHECK(document.getMember("test1", "a").asJson(0, false) == R"("test1":{"a":[1]})");
+
+    string const openData = R"({"t0": {"a": false}, "t1": {"b": 1}})";
+    LazyJsonDocument const openDocument{ReadOnlyView(openData)};
+    BOOST_CHECK(openDocument.getKeys() == std::vector<string>({"t0"}));
+    BOOST_CHECK(openDocument.getMember("t0", "t1").asJson(0, false) == R"("t0":{"t1":{"b":1}})");
+
+    // Valid json the previous parser could not read is read as json
+    BOOST_CHECK(ConvertJsoncppStringToData(R"({"a" : [ false, true ]})").asJson(0, false) ==
+                R"({"a":[false,true]})");
+    BOOST_CHECK(ConvertJsoncppStringToData("{\"a\" : false, \"b\" : { \"c\" : false }}\n")
+                    .asJson(0, false) == R"({"a":false,"b":{"c":false}})");
+    BOOST_CHECK(ConvertJsoncppStringToData("{\"a\" : [[1, 2], []]}").asJson(0, false) ==
+                R"({"a":[[1,2],[]]})");
+}
+
+BOOST_AUTO_TEST_CASE(dataobject_binaryFormat)
+{
+    string const data = R"({
+        "b" : { "key" : [ -12, true, null, "", { "key" : "0x01" } ], "empty" : {} },
+        "a" : { "key" : [], "int" : 2147483647 }
+    })";
+    DataObject const dObj = ConvertJsoncppStringToData(data, string(), true);
+    ReadOnlyView const binary("header" + ConvertDataToBinary(dObj));
+    DataObject const restored = ConvertBinaryToData(binary, 6);
+    BOOST_CHECK(restored.asJson(0, false) == dObj.asJson(0, false));
+    BOOST_CHECK(restored.atKey("a").isAutosort() && restored.atKey("a").isOverwritable());
+    BOOST_CHECK(restored.atKey("b").atKey("key").at(4).atKey("key").asString() == "0x01");
+
+    // key "key" is stored once
+    string const binaryData = binary.toString().substr(6);
+    BOOST_CHECK(binaryData.find("key") == binaryData.rfind("key"));
+
+    ReadOnlyView const truncated(binaryData.substr(0, binaryData.size() - 1));
+    BOOST_CHECK_THROW(ConvertBinaryToData(truncated), DataObjectException);
+    ReadOnlyView const otherVersion(binaryData.substr(0, 4) + char(2) + binaryData.substr(5));
+    BOOST_CHECK_THROW(ConvertBinaryToData(otherVersion), DataObjectException);
+}
+
+BOOST_AUTO_TEST_CASE(dataobject_lazyDocument)
+{
+    string const data = R"({
+        "test2" : { "_info" : { "comment" : "b" }, "post" : [ { "hash" : "0x02" } ] },
+        "test1" : { "env" : { "_info" : 5 }, "_info" : { "comment" : "a" } },
+        "test3" : [ 1, { "_info" : 2 } ],
+        "test1" : { "post" : [ "x", [] ], "_info" : { "comment" : "c" } }
+    })";
+    ReadOnlyView const source(data);
+    LazyJsonDocument const document(source, true);
+    BOOST_CHECK(document.getKeys() == std::vector<string>({"test2", "test1", "test3"}));
+    BOOST_CHECK(document.count("test3") && !document.count("test4"));
+    BOOST_CHECK(document.getMembers().asJson(0, false) ==
+                ConvertJsoncppStringToData(data, string(), true).asJson(0, false));
+
+    DataObject const selected =
+        document.getMembers([](string const& _key) { return _key != "test1"; });
+    BOOST_CHECK(selected.getSubObjects().size() == 2);
+    BOOST_CHECK(selected.atKey("test2").asJson(0, false) ==
+                R"("test2":{"_info":{"comment":"b"},"post":[{"hash":"0x02"}]})");
+
+    BOOST_CHECK(document.getMember("test1", "_info").asJson(0, false) ==
+                R"("test1":{"_info":{"comment":"c"}})");
+    BOOST_CHECK(document.getMember("test3", "_info").type() == DataType::Array);
+    BOOST_CHECK(document.getMember("test2", "env").getSubObjects().empty());
+
+    ReadOnlyView const broken(string(R"({"test1" : { "a" : [ 1 } })"));
+    BOOST_CHECK_THROW(LazyJsonDocument document(broken), DataObjectException);
+}
 
 BOOST_AUTO_TEST_CASE(dataobject_findOrderedKeyPosition_before1_of3)
 {
@@ -737,4 +974,231 @@ BOOST_AUTO_TEST_CASE(dataobject_jsonOrder)
                 "\"7\",\"aa70\":\"7\",\"aa8\":\"8\"}");
 }
 
+BOOST_AUTO_TEST_CASE(dataobject_streamJson)
+{
+    string const data = R"(
+    {
+        "name" : {
+            "array" : [ "0x01", 2, -3 ],
+            "text" : "line",
+            "empty" : {
+            },
+            "bool" : true
+        }
+    })";
+    DataObject dObj = ConvertJsoncppStringToData(data);
+    string const expected = "{\"name\":{\"array\":[\"0x01\",2,-3],\"text\":\"line\",\"empty\":{},"
+                            "\"bool\":true}}";
+    BOOST_CHECK(dObj.asJson(0, false) == expected);
+
+    // buffer smaller than the output is flushed many times
+    string out;
+    {
+        class SmallBufferOutput : public JsonOutput
+        {
+        public:
+            SmallBufferOutput(string& _out) : JsonOutput(3), m_out(_out) {}
+            ~SmallBufferOutput() { flush(); }
+
+        protected:
+            void consume(char const* _data, size_t _size) override { m_out.append(_data, _size); }
+
+        private:
+            string& m_out;
+        };
+        SmallBufferOutput output(out);
+        dObj.streamJson(output, 0, true);
+    }
+    BOOST_CHECK(out == dObj.asJson());
+}
+
+BOOST_AUTO_TEST_CASE(dataobject_copyOnWrite)
+{
+    string const data = R"({
+        "env" : { "number" : "0x01", "coinbase" : "0xaa" },
+        "pre" : { "0x01" : { "nonce" : "0x00", "storage" : { "0x00" : "0x01" } } }
+    })";
+    DataObject const source = ConvertJsoncppStringToData(data);
+
+    // copies share the subtrees
+    DataObject copy = source;
+    BOOST_CHECK(&copy.getSubObjects() == &source.getSubObjects());
+    BOOST_CHECK(&copy.atKey("pre").getSubObjects() == &source.atKey("pre").getSubObjects());
+
+    // modification of the copy detaches only the modified path
+    copy["pre"]["0x01"]["storage"]["0x00"] = string("0x02");
+    copy["env"].removeKey("coinbase");
+    BOOST_CHECK(&copy.getSubObjects() != &source.getSubObjects());
+    DataObject const& storage = copy.atKey("pre").atKey("0x01").atKey("storage");
+    DataObject const& sourceStorage = source.atKey("pre").atKey("0x01").atKey("storage");
+    BOOST_CHECK(storage.atKey("0x00").asString() == "0x02");
+    BOOST_CHECK(sourceStorage.atKey("0x00").asString() == "0x01");
+    BOOST_CHECK(!copy.atKey("env").count("coinbase"));
+    BOOST_CHECK(source.atKey("env").count("coinbase"));
+    BOOST_CHECK(source.asJson(0, false) == ConvertJsoncppStringToData(data).asJson(0, false));
+
+    // assignment into a keyed element shares the subtree as well
+    DataObject test;
+    test["env"] = source.atKey("env");
+    BOOST_CHECK(&test.atKey("env").getSubObjects() == &source.atKey("env").getSubObjects());
+    test["env"]["number"] = string("0x02");
+    BOOST_CHECK(source.atKey("env").atKey("number").asString() == "0x01");
+    BOOST_CHECK(test.atKey("env").getKey() == "env");
+}
+
+BOOST_AUTO_TEST_CASE(dataobject_hexValues)
+{
+    DataObject data = ConvertJsoncppStringToData(R"({
+        "balance" : "0x0de0b6b3a7640000",
+        "decimal" : "100",
+        "hash" : "0x0000000000000000000000000000000000000000000000000000000000000001",
+        "address" : "0x095e7baea6a6c7c4c2dfeb977efac326af552d87"
+    })");
+    BOOST_CHECK(data.atKey("balance").asU256() == dev::u256("1000000000000000000"));
+    BOOST_CHECK(data.atKey("decimal").asU256() == 100);
+    BOOST_CHECK(data.atKey("hash").asH256() == dev::h256(1));
+    BOOST_CHECK(data.atKey("address").asH160() ==
+                dev::h160("0x095e7baea6a6c7c4c2dfeb977efac326af552d87"));
+    BOOST_CHECK(data.atKey("address").asBytes().size() == 20);
+
+    // parsed value is dropped when the string is changed
+    data["decimal"] = string("0x10");
+    BOOST_CHECK(data.atKey("decimal").asU256() == 16);
+
+    // native value is written as hex text when requested
+    DataObject test;
+    test["number"].setU256(256);
+    test["bytes"].setBytes(dev::bytes{0x00, 0x01});
+    BOOST_CHECK(test.atKey("number").asU256() == 256);
+    BOOST_CHECK(test.asJson(0, false) == R"({"number":"0x0100","bytes":"0x0001"})");
+    DataObject copy = test;
+    BOOST_CHECK(copy.atKey("number").asString() == "0x0100");
+    BOOST_CHECK(copy.atKey("bytes").asH160() == dev::h160());
+}
+
+BOOST_AUTO_TEST_CASE(dataobject_structuralHash)
+{
+    string const data = R"({
+        "pre" : { "0x01" : { "nonce" : "0x00", "code" : "", "storage" : { "0x00" : 1 } } },
+        "list" : [ true, "0x01", 2 ]
+    })";
+    DataObject const a = ConvertJsoncppStringToData(data);
+    DataObject b = ConvertJsoncppStringToData(data);
+    BOOST_CHECK(a.structuralHash() == b.structuralHash());
+    BOOST_CHECK(a == b);
+
+    // own key is not a part of the hash, keys of the subobjects are
+    DataObject c = a.atKey("pre");
+    c.setKey("other");
+    BOOST_CHECK(c.structuralHash() == a.atKey("pre").structuralHash());
+    c.renameKey("0x01", "0x02");
+    BOOST_CHECK(c.structuralHash() != a.atKey("pre").structuralHash());
+    BOOST_CHECK(!(c == a.atKey("pre")));
+
+    // modification of a subobject changes hashes along the path
+    size_t const hash = b.structuralHash();
+    b["pre"]["0x01"]["storage"]["0x00"] = 2;
+    BOOST_CHECK(b.structuralHash() != hash);
+    BOOST_CHECK(!(a == b));
+    b["pre"]["0x01"]["storage"]["0x00"] = 1;
+    BOOST_CHECK(b.structuralHash() == hash);
+    BOOST_CHECK(a == b);
+
+    // a subobject modified through a reference leaves the hashes of its parents stale,
+    // == compares the values
+    DataObject x = ConvertJsoncppStringToData(R"({ "x" : { "y" : "1" } })");
+    DataObject const y = ConvertJsoncppStringToData(R"({ "x" : { "y" : "2" } })");
+    DataObject& value = x["x"]["y"];
+    x.structuralHash();
+    value = "2";
+    BOOST_CHECK(x == y);
+
+    BOOST_CHECK(a.atKey("list").at(0) == true);
+    BOOST_CHECK(!(a.atKey("list").at(0) == false));
+}
+
+BOOST_AUTO_TEST_CASE(dataobject_readYamlEvents)
+{
+    string const yaml = R"(
+test:
+  //comment: { a: 1, b: [ 1, 2 ] }
+  env: &env
+    number: 1
+    //note: x
+  pre:
+    - a: !!int 1
+      b: ~
+    - [ text, '2' ]
+  env2: *env
+)";
+    ReadOnlyView const source(yaml);
+    BOOST_CHECK(ConvertYamlToData(source).asJson(0, false) ==
+                convertYamlNode(YAML::Load(yaml)).asJson(0, false));
+    BOOST_CHECK(ConvertYamlToData(source, KeyFilter().skipPrefix("//")).asJson(0, false) ==
+                R"({"test":{"env":{"number":"1"},"env2":{"number":"1"},)"
+                R"("pre":[{"a":1,"b":{}},["text","2"]]}})");
+
+    // Anchors defined in the filtered members are still read for the aliases
+    string const anchors = R"(
+test:
+  //note: &v 0x01
+  //list: [ &n !!int 2, { x: &m { y: 3 } } ]
+  value: *v
+  number: *n
+  map: *m
+)";
+    BOOST_CHECK(ConvertYamlToData(ReadOnlyView(anchors), KeyFilter().skipPrefix("//"))
+                    .asJson(0, false) ==
+                R"({"test":{"map":{"y":"3"},"number":2,"value":"0x01"}})");
+    BOOST_CHECK(ConvertYamlToData(ReadOnlyView(string())).type() == DataType::Null);
+    BOOST_CHECK_THROW(ConvertYamlToData(ReadOnlyView(string("? [a, b]\n: 1\n"))),
+        DataObjectException);
+}
+
+BOOST_AUTO_TEST_CASE(dataobject_writeFileParallel)
+{
+    DataObject dObj = ConvertJsoncppStringToData(R"({
+        "test1" : { "pre" : [ "0x01", 2 ], "text" : "a\tb" },
+        "test2" : {},
+        "test3" : [ { "nonce" : "0x00" } ],
+        "test4" : true
+    })");
+    dObj["test3"].addArrayObject(dObj.atKey("test1"));  // shared subtree
+    dObj["test2"]["balance"].setU256(256);
+    boost::filesystem::path const file =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    for (bool pretty : {true, false})
+    {
+        WriteDataObjectToFile(file, dObj, pretty, 3);
+        BOOST_CHECK(asString(contents(file)) == dObj.asJson(0, pretty));
+        WriteDataObjectToFile(file, dObj.atKey("test3"), pretty, 8);
+        BOOST_CHECK(asString(contents(file)) == dObj.atKey("test3").asJson(0, pretty));
+    }
+    boost::filesystem::remove(file);
+}
+
+BOOST_AUTO_TEST_CASE(dataobject_hashJson)
+{
+    // hash of the input given in parts
+    string input;
+    for (size_t i = 0; i < 600; i++)
+        input += char('a' + i % 26);
+    for (size_t size : {0, 1, 135, 136, 137, 272, 600})
+    {
+        SHA3Stream stream;
+        string const part = input.substr(0, size);
+        stream.append(part.substr(0, size / 3));
+        stream.append(part.substr(size / 3));
+        BOOST_CHECK(stream.hash() == sha3(part));
+    }
+
+    DataObject dObj = ConvertJsoncppStringToData(R"({
+        "test" : { "pre" : [ "0x01", 2, true ], "text" : "a\tb", "empty" : {} }
+    })");
+    for (size_t i = 0; i < 5000; i++)
+        dObj["test"]["pre"].addArrayObject(DataObject(toString(i)));
+    BOOST_CHECK(HashDataObjectJson(dObj, false) == sha3(dObj.asJson(0, false)));
+    BOOST_CHECK(HashDataObjectJson(dObj) == sha3(dObj.asJson()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
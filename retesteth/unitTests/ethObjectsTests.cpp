@@ -240,6 +240,124 @@ BOOST_AUTO_TEST_CASE(object_stringIntegerType_otherTypes)
 	BOOST_CHECK(object::stringIntegerType("11223344abcdeffzz") == object::DigitsType::String);
 }
 
+BOOST_AUTO_TEST_CASE(object_stringIntegerType_longStrings)
+{
+    // long strings are checked 16 chars at once, a wrong char is found at any position
+    string const hex = "0x" + string(64, 'a') + string(64, '1') + string(64, 'F');
+    BOOST_CHECK(object::stringIntegerType(hex) == object::DigitsType::HexPrefixed);
+    BOOST_CHECK(object::stringIntegerType(hex.substr(2)) == object::DigitsType::Hex);
+    BOOST_CHECK(object::stringIntegerType(string(100, '7')) == object::DigitsType::Decimal);
+    BOOST_CHECK(object::stringIntegerType(string(101, '7')) == object::DigitsType::Decimal);
+    BOOST_CHECK(
+        object::stringIntegerType("0x" + string(33, '0')) == object::DigitsType::UnEvenHexPrefixed);
+    for (size_t i = 2; i < hex.size(); i++)
+    {
+        for (char ch : {'g', 'G', 'x', '/', ':', '@', '`', '\xff'})
+        {
+            string wrong = hex;
+            wrong[i] = ch;
+            BOOST_CHECK(object::stringIntegerType(wrong) == object::DigitsType::String);
+        }
+    }
+
+    // no shared state between the parsing threads
+    vector<thread> threads;
+    for (size_t i = 0; i < 4; i++)
+        threads.emplace_back([&hex]() {
+            for (size_t j = 0; j < 1000; j++)
+                ETH_FAIL_REQUIRE(
+                    object::stringIntegerType(hex) == object::DigitsType::HexPrefixed);
+        });
+    for (auto& th : threads)
+        th.join();
+}
+
+BOOST_AUTO_TEST_CASE(object_precompiledForNetwork)
+{
+    scheme_state const state(DataObject(DataType::Object));
+    DataObject const eip158 = state.getDataForRPC(Fork::EIP158);
+    BOOST_CHECK_EQUAL(eip158.getSubObjects().size(), 4u);
+    BOOST_CHECK_EQUAL(
+        eip158.atKey("0x0000000000000000000000000000000000000004").atKey("precompiled").atKey(
+            "name").asString(), "identity");
+
+    DataObject const byzantium = state.getDataForRPC(Fork::Byzantium);
+    BOOST_CHECK_EQUAL(byzantium.getSubObjects().size(), 8u);
+    DataObject const& modexp =
+        byzantium.atKey("0x0000000000000000000000000000000000000005").atKey("precompiled");
+    BOOST_CHECK_EQUAL(modexp.atKey("name").asString(), "modexp");
+    BOOST_CHECK(!modexp.count("linear"));
+    DataObject const& mul =
+        byzantium.atKey("0x0000000000000000000000000000000000000007").atKey("precompiled");
+    BOOST_CHECK_EQUAL(mul.atKey("linear").atKey("base").asInt(), 40000);
+    BOOST_CHECK(forkInfo(toFork("ConstantinopleFix")).blockReward == 2000000000000000000);
+}
+
+BOOST_AUTO_TEST_CASE(object_blockRLP)
+{
+    DataObject transaction;
+    transaction["blockHash"] = "0x" + string(64, '1');
+    transaction["blockNumber"] = "0x01";
+    transaction["from"] = "0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b";
+    transaction["gas"] = "0x05f5e100";
+    transaction["gasPrice"] = "0x01";
+    transaction["hash"] = "0x" + string(64, '2');
+    transaction["input"] = "0x" + string(200, 'a');
+    transaction["nonce"] = "0x00";
+    transaction["to"] = DataObject(DataType::Null);
+    transaction["v"] = "0x01";
+    transaction["r"] = "0x98ff921201554726367d2be8c804a7ff89ccf285ebc57dff8ae4c44b9c19ac4a";
+    transaction["s"] = "0x7f";
+    transaction["transactionIndex"] = "0x00";
+    transaction["value"] = "0x0de0b6b3a7640000";
+
+    DataObject block;
+    block["author"] = "0x2adc25665018aa1fe0e6bc666dac8fc2697ff9ba";
+    block["difficulty"] = "0x020000";
+    block["extraData"] = "0x42";
+    block["gasLimit"] = "0x7fffffffffffffff";
+    block["gasUsed"] = "0x00";
+    block["hash"] = "0x" + string(64, '3');
+    block["logsBloom"] = "0x" + string(512, '0');
+    block["number"] = "0x01";
+    block["parentHash"] = "0x" + string(64, '4');
+    block["receiptsRoot"] = "0x" + string(64, '5');
+    block["sha3Uncles"] = "0x" + string(64, '6');
+    block["size"] = "0x01";
+    block["stateRoot"] = "0x" + string(64, '7');
+    block["timestamp"] = "0x03e8";
+    block["totalDifficulty"] = "0x020000";
+    block["transactionsRoot"] = "0x" + string(64, '8');
+    block["uncles"] = DataObject(DataType::Array);
+    block["transactions"].addArrayObject(transaction);
+    transaction["to"] = "0x095e7baea6a6c7c4c2dfeb977efac326af552d87";
+    transaction["nonce"] = "0x01";
+    block["transactions"].addArrayObject(transaction);
+
+    bytes const rlpBytes = fromHex(scheme_block(block).getBlockRLP());
+    RLP const rlp(rlpBytes);
+    BOOST_REQUIRE(rlp.isList() && rlp.itemCount() == 3);
+    BOOST_CHECK_EQUAL(rlp.actualSize(), rlpBytes.size());
+    RLP const header = rlp[0];
+    BOOST_REQUIRE_EQUAL(header.itemCount(), 15u);
+    BOOST_CHECK(header[0].toHash<h256>() == h256("0x" + string(64, '4')));
+    BOOST_CHECK(header[2].toHash<h160>() == h160(block.atKey("author").asString()));
+    BOOST_CHECK(header[9].toInt<u256>() == u256("0x7fffffffffffffff"));
+    BOOST_CHECK(header[11].toInt<u256>() == 1000);
+    BOOST_CHECK(header[13].toHash<h256>() == h256(0));
+
+    RLP const transactions = rlp[1];
+    BOOST_REQUIRE_EQUAL(transactions.itemCount(), 2u);
+    BOOST_CHECK(transactions[0][3].isEmpty());
+    BOOST_CHECK_EQUAL(transactions[0][5].toBytes().size(), 100u);
+    BOOST_CHECK(transactions[0][6].toInt<u256>() == 28);
+    BOOST_CHECK(transactions[1][0].toInt<u256>() == 1);
+    BOOST_CHECK(transactions[1][3].toHash<h160>() == h160(transaction.atKey("to").asString()));
+    BOOST_CHECK(transactions[1][4].toInt<u256>() == u256("1000000000000000000"));
+    BOOST_CHECK(transactions[1][7].toInt<u256>() == u256(transaction.atKey("r").asString()));
+    BOOST_CHECK(rlp[2].isList() && rlp[2].itemCount() == 0);
+}
+
 
 void testCompareResult(
     DataObject const& _exp, DataObject const& _post, CompareResult _expResult, size_t errCount = 2)